@@ -0,0 +1,67 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        AlignedAllocator.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Minimal standard-conforming allocator that over-aligns its
+//              allocations (e.g. to a cache line). Used for the World's flat
+//              cell buffers so each row starts on a cache line boundary.
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+
+// **=== Constants ===**
+
+/** @brief Assumed size of a CPU cache line in bytes. */
+inline constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief Allocator returning memory aligned to at least Alignment bytes.
+ * @tparam T The value type being allocated.
+ * @tparam Alignment Required alignment in bytes (power of two).
+ */
+template <typename T, std::size_t Alignment = CACHE_LINE_SIZE>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    static_assert((Alignment & (Alignment - 1)) == 0, "Alignment must be a power of two.");
+    static_assert(Alignment >= alignof(T), "Alignment must be at least the natural alignment of T.");
+
+    /** @brief Rebind helper, required because of the non-type template parameter. */
+    template <typename U>
+    struct rebind { using other = AlignedAllocator<U, Alignment>; };
+
+    AlignedAllocator() noexcept = default;
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    /**
+     * @brief Allocates uninitialised storage for n objects of type T.
+     * @param n Number of objects.
+     * @return T* Pointer to the aligned storage.
+     */
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ Alignment }));
+    }
+
+    /**
+     * @brief Releases storage previously obtained from allocate().
+     * @param p Pointer returned by allocate().
+     * @param n Number of objects (unused).
+     */
+    void deallocate(T* p, std::size_t n) noexcept {
+        (void)n;
+        ::operator delete(p, std::align_val_t{ Alignment });
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
@@ -0,0 +1,482 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        BenchmarkMain.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.3
+// Description: Main entry point for the World::update macro benchmark.
+//              Runs every scenario across a set of grid sizes, engines,
+//              thread counts and update orders, and reports tick time statistics, throughput and
+//              peak memory as a table and as JSON for comparing runs.
+// ============================================================================
+
+#include "World.h"
+#include "CompactWorld.h"
+#include "JobSystem.h"
+#include "Scenarios.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__linux__)
+#include <malloc.h>
+#else
+#include <sys/resource.h>
+#endif
+
+// **=== Types ===**
+
+/**
+ * @brief Settings of a benchmark session, filled from the command line.
+ */
+struct BenchmarkOptions {
+    std::vector<std::string> scenarios = { "sandpile", "slosh", "grassfield", "sandwater", "meadow", "static", "allawake" };
+    std::vector<std::pair<int, int>> sizes = { { 320, 180 }, { 1024, 576 }, { 2048, 2048 }, { 4096, 4096 } }; // cols x rows
+    std::vector<int> threads;          // Empty = 1, 2, 4, ... up to the hardware thread count
+    std::vector<std::string> orders = { "rows", "batched" }; // Update orders (World::setBatchByType())
+    std::vector<std::string> engines = { "objects", "compact" }; // World, CompactWorld (single-threaded, one order)
+    int warmupTicks = 20;              // Ticks run before timing starts
+    int ticks = 200;                   // Ticks timed per run
+    std::uint64_t seed = World::DEFAULT_SEED;
+    std::string jsonPath = "benchmark_results.json";
+    bool showHelp = false;
+};
+
+/**
+ * @brief Measurements of one scenario/size/thread-count run.
+ */
+struct BenchmarkResult {
+    std::string scenario;
+    std::string engine;
+    int cols = 0;
+    int rows = 0;
+    int threads = 0;
+    std::string order;
+    double meanTickMs = 0.0;
+    double p50TickMs = 0.0;
+    double p99TickMs = 0.0;
+    double cellsPerSecond = 0.0;       // Grid cells (rows * cols) advanced per second
+    double awakeCellsPerSecond = 0.0;  // Awake cells actually swept per second
+    double setupMs = 0.0;
+    std::size_t peakMemoryBytes = 0;   // Peak resident memory of the run (see resetPeakMemory())
+};
+
+// **=== Memory Helpers ===**
+
+#if defined(__linux__)
+/**
+ * @brief Reads one memory figure from /proc/self/status.
+ * @param key The field name with its colon, e.g. "VmHWM:".
+ * @return std::size_t Bytes, or 0 when unavailable.
+ */
+static std::size_t readStatusBytes(const std::string& key) {
+    std::ifstream status("/proc/self/status");
+    std::string line;
+    while (std::getline(status, line)) {
+        if (line.rfind(key, 0) == 0) {
+            return static_cast<std::size_t>(std::stoull(line.substr(key.size()))) * 1024; // Reported in kB
+        }
+    }
+    return 0;
+}
+#endif
+
+/**
+ * @brief Starts measuring a run's peak memory.
+ * On Linux, heap kept from earlier runs is first handed back to the OS, then the
+ * peak counter is reset to the resident set size, which becomes the baseline: the
+ * run's peak above it does not depend on which runs came before. Elsewhere the peak
+ * cannot be reset and the baseline is 0, so the peak is the high-water mark of the
+ * whole process, which still matches the run because runs go from the smallest grid
+ * to the largest.
+ * @return std::size_t The baseline in bytes, for getPeakMemoryBytes().
+ */
+static std::size_t resetPeakMemory() {
+#if defined(__linux__)
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) {
+        clearRefs << "5"; // Resets VmHWM to the current resident set size
+        clearRefs.close();
+        return readStatusBytes("VmRSS:");
+    }
+#endif
+    return 0;
+}
+
+/**
+ * @brief Gets the peak resident memory of the process above a baseline.
+ * @param baseline Bytes returned by resetPeakMemory() before the run.
+ * @return std::size_t Bytes, or 0 when unavailable.
+ */
+static std::size_t getPeakMemoryBytes(std::size_t baseline) {
+    std::size_t peak = 0;
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters{};
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        peak = counters.PeakWorkingSetSize;
+    }
+#elif defined(__linux__)
+    peak = readStatusBytes("VmHWM:");
+#else
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    peak = static_cast<std::size_t>(usage.ru_maxrss); // Bytes on macOS
+#endif
+    return peak > baseline ? peak - baseline : 0;
+}
+
+// **=== Command Line ===**
+
+/**
+ * @brief Splits a comma separated list.
+ */
+static std::vector<std::string> splitList(const std::string& list) {
+    std::vector<std::string> items;
+    std::stringstream stream(list);
+    std::string item;
+    while (std::getline(stream, item, ',')) {
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+/**
+ * @brief Prints the command line usage.
+ */
+static void printUsage(std::ostream& out) {
+    out << "Usage: falling_sand_benchmark [options]\n"
+        << "  --scenarios A,B,...   Scenarios to run (default sandpile,slosh,grassfield,sandwater,meadow,static,allawake)\n"
+        << "  --sizes WxH,...       Grid sizes as columns x rows (default 320x180,1024x576,2048x2048,4096x4096)\n"
+        << "  --threads N,...       Thread counts (default 1, 2, 4, ... up to the hardware thread count)\n"
+        << "  --orders A,B          Update orders: rows, batched (default both)\n"
+        << "  --engines A,B         Engines: objects, compact (default both)\n"
+        << "  --ticks N             Ticks timed per run (default 200)\n"
+        << "  --warmup N            Untimed ticks before each run (default 20)\n"
+        << "  --seed N              Random seed (default " << World::DEFAULT_SEED << ")\n"
+        << "  --json PATH           JSON output file (default benchmark_results.json)\n"
+        << "  --quick               Only the 320x180 and 1024x576 grids, 50 ticks\n"
+        << "  --help                Show this message\n"
+        << "Scenarios:";
+    for (const std::string& name : Scenarios::getNames()) {
+        out << " " << name;
+    }
+    out << "\n";
+}
+
+/**
+ * @brief Parses the command line. Throws std::invalid_argument on bad input.
+ */
+static BenchmarkOptions parseOptions(int argc, char** argv) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            options.showHelp = true;
+            continue;
+        }
+        if (arg == "--quick") {
+            options.sizes = { { 320, 180 }, { 1024, 576 } };
+            options.ticks = 50;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+        const std::string value = argv[++i];
+
+        if (arg == "--scenarios") {
+            options.scenarios = splitList(value);
+        }
+        else if (arg == "--sizes") {
+            options.sizes.clear();
+            for (const std::string& size : splitList(value)) {
+                const std::size_t x = size.find('x');
+                if (x == std::string::npos) {
+                    throw std::invalid_argument("Grid size must look like 320x180: " + size);
+                }
+                options.sizes.emplace_back(std::stoi(size.substr(0, x)), std::stoi(size.substr(x + 1)));
+            }
+        }
+        else if (arg == "--threads") {
+            options.threads.clear();
+            for (const std::string& count : splitList(value)) {
+                options.threads.push_back(std::stoi(count));
+            }
+        }
+        else if (arg == "--orders") {
+            options.orders = splitList(value);
+            for (const std::string& order : options.orders) {
+                if (order != "rows" && order != "batched") {
+                    throw std::invalid_argument("Unknown update order: " + order);
+                }
+            }
+        }
+        else if (arg == "--engines") {
+            options.engines = splitList(value);
+            for (const std::string& engine : options.engines) {
+                if (engine != "objects" && engine != "compact") {
+                    throw std::invalid_argument("Unknown engine: " + engine);
+                }
+            }
+        }
+        else if (arg == "--ticks")  { options.ticks = std::stoi(value); }
+        else if (arg == "--warmup") { options.warmupTicks = std::stoi(value); }
+        else if (arg == "--seed")   { options.seed = std::stoull(value); }
+        else if (arg == "--json")   { options.jsonPath = value; }
+        else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    if (options.ticks <= 0 || options.warmupTicks < 0) {
+        throw std::invalid_argument("--ticks must be positive and --warmup must not be negative.");
+    }
+
+    // Default thread counts: powers of two up to the hardware, plus the hardware count itself
+    if (options.threads.empty()) {
+        const int hardware = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        for (int count = 1; count < hardware; count *= 2) {
+            options.threads.push_back(count);
+        }
+        options.threads.push_back(hardware);
+    }
+    return options;
+}
+
+// **=== Benchmark ===**
+
+/**
+ * @brief Runs the warmup and timed ticks of a filled world and fills in the timing statistics.
+ */
+template <typename WorldType>
+static void timeTicks(const BenchmarkOptions& options, WorldType& world, std::size_t memoryBaseline, BenchmarkResult& result) {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    for (int tick = 0; tick < options.warmupTicks; ++tick) {
+        world.update();
+    }
+
+    // --- Timed Ticks ---
+    std::vector<double> tickMs(static_cast<std::size_t>(options.ticks));
+    double awakeCells = 0.0;
+    for (int tick = 0; tick < options.ticks; ++tick) {
+        awakeCells += world.getAwakeCellCount(); // Cells the coming tick will sweep (counted outside the timer)
+        const Clock::time_point start = Clock::now();
+        world.update();
+        tickMs[tick] = Milliseconds(Clock::now() - start).count();
+    }
+
+    // --- Statistics ---
+    double totalMs = 0.0;
+    for (double ms : tickMs) {
+        totalMs += ms;
+    }
+    std::sort(tickMs.begin(), tickMs.end());
+    auto percentile = [&tickMs](double p) { // Nearest-rank percentile
+        std::size_t rank = static_cast<std::size_t>(p * tickMs.size() + 0.999999);
+        return tickMs[std::clamp<std::size_t>(rank, 1, tickMs.size()) - 1];
+    };
+    result.meanTickMs = totalMs / options.ticks;
+    result.p50TickMs = percentile(0.50);
+    result.p99TickMs = percentile(0.99);
+    const double totalSeconds = totalMs / 1000.0;
+    if (totalSeconds > 0.0) {
+        result.cellsPerSecond = static_cast<double>(result.rows) * result.cols * options.ticks / totalSeconds;
+        result.awakeCellsPerSecond = awakeCells / totalSeconds;
+    }
+    result.peakMemoryBytes = getPeakMemoryBytes(memoryBaseline);
+}
+
+/**
+ * @brief Builds a world for one configuration, runs it and measures every timed tick.
+ */
+static BenchmarkResult runBenchmark(const BenchmarkOptions& options, const std::string& scenario, int cols, int rows, int threads, const std::string& order) {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    BenchmarkResult result;
+    result.scenario = scenario;
+    result.engine = "objects";
+    result.cols = cols;
+    result.rows = rows;
+    result.order = order;
+
+    const std::size_t memoryBaseline = resetPeakMemory();
+
+    // --- Setup ---
+    const Clock::time_point setupStart = Clock::now();
+    World world(rows, cols, options.seed);
+    std::unique_ptr<JobSystem> jobs;
+    if (threads != 1) {
+        jobs = std::make_unique<JobSystem>(threads);
+        world.setJobSystem(jobs.get());
+    }
+    world.setSurfaceHeightValidation(false); // Full rescans would swamp the numbers in debug builds
+    world.setBatchByType(order == "batched");
+    Scenarios::apply(world, scenario);
+    result.threads = world.getThreadCount();
+    result.setupMs = Milliseconds(Clock::now() - setupStart).count();
+
+    timeTicks(options, world, memoryBaseline, result);
+    return result;
+}
+
+/**
+ * @brief Same as runBenchmark(), on a CompactWorld (always one thread, row order).
+ */
+static BenchmarkResult runCompactBenchmark(const BenchmarkOptions& options, const std::string& scenario, int cols, int rows) {
+    using Clock = std::chrono::steady_clock;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    BenchmarkResult result;
+    result.scenario = scenario;
+    result.engine = "compact";
+    result.cols = cols;
+    result.rows = rows;
+    result.threads = 1;
+    result.order = "rows";
+
+    const std::size_t memoryBaseline = resetPeakMemory();
+
+    // --- Setup ---
+    const Clock::time_point setupStart = Clock::now();
+    CompactWorld world(rows, cols, options.seed);
+    Scenarios::apply(world, scenario);
+    result.setupMs = Milliseconds(Clock::now() - setupStart).count();
+
+    timeTicks(options, world, memoryBaseline, result);
+    return result;
+}
+
+/**
+ * @brief Writes every result as JSON.
+ */
+static void writeJson(const std::string& path, const BenchmarkOptions& options, const std::vector<BenchmarkResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Failed to open JSON output: " + path);
+    }
+    out << std::setprecision(6);
+    out << "{\n"
+        << "  \"benchmark\": \"world_update\",\n"
+        << "  \"seed\": " << options.seed << ",\n"
+        << "  \"warmupTicks\": " << options.warmupTicks << ",\n"
+        << "  \"ticks\": " << options.ticks << ",\n"
+        << "  \"hardwareThreads\": " << std::thread::hardware_concurrency() << ",\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        out << "    { \"scenario\": \"" << r.scenario << "\""
+            << ", \"engine\": \"" << r.engine << "\""
+            << ", \"cols\": " << r.cols
+            << ", \"rows\": " << r.rows
+            << ", \"threads\": " << r.threads
+            << ", \"order\": \"" << r.order << "\""
+            << ", \"meanTickMs\": " << r.meanTickMs
+            << ", \"p50TickMs\": " << r.p50TickMs
+            << ", \"p99TickMs\": " << r.p99TickMs
+            << ", \"cellsPerSec\": " << r.cellsPerSecond
+            << ", \"awakeCellsPerSec\": " << r.awakeCellsPerSecond
+            << ", \"setupMs\": " << r.setupMs
+            << ", \"peakMemoryBytes\": " << r.peakMemoryBytes
+            << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+ * @brief Main entry point of the benchmark.
+ */
+int main(int argc, char** argv)
+{
+    BenchmarkOptions options;
+    try {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e) { // std::stoi throws invalid_argument/out_of_range too
+        std::cerr << "[ERROR] " << e.what() << "\n";
+        printUsage(std::cerr);
+        return 1;
+    }
+    if (options.showHelp) {
+        printUsage(std::cout);
+        return 0;
+    }
+
+    try {
+        std::vector<BenchmarkResult> results;
+        std::cout << std::left << std::setw(12) << "scenario" << std::setw(11) << "grid" << std::setw(9) << "engine"
+                  << std::setw(8) << "threads" << std::setw(9) << "order"
+                  << std::right << std::setw(10) << "mean ms" << std::setw(10) << "p50 ms" << std::setw(10) << "p99 ms"
+                  << std::setw(13) << "Mcells/s" << std::setw(13) << "Mawake/s" << std::setw(10) << "peak MB" << "\n";
+        std::cout << std::fixed << std::setprecision(3);
+
+        auto report = [&results](BenchmarkResult r) {
+            std::cout << std::left << std::setw(12) << r.scenario
+                      << std::setw(11) << (std::to_string(r.cols) + "x" + std::to_string(r.rows))
+                      << std::setw(9) << r.engine << std::setw(8) << r.threads << std::setw(9) << r.order << std::right
+                      << std::setw(10) << r.meanTickMs << std::setw(10) << r.p50TickMs << std::setw(10) << r.p99TickMs
+                      << std::setw(13) << r.cellsPerSecond / 1e6 << std::setw(13) << r.awakeCellsPerSecond / 1e6
+                      << std::setw(10) << r.peakMemoryBytes / (1024.0 * 1024.0) << std::endl;
+            results.push_back(std::move(r));
+        };
+
+        // Every configuration; smallest grids first, so a non-resettable peak still belongs to the current size
+        auto runAll = [](const BenchmarkOptions& runOptions, const auto& onResult) {
+            for (const std::pair<int, int>& size : runOptions.sizes) {
+                for (const std::string& scenario : runOptions.scenarios) {
+                    for (const std::string& engine : runOptions.engines) {
+                        if (engine == "compact") {
+                            onResult(runCompactBenchmark(runOptions, scenario, size.first, size.second));
+                            continue;
+                        }
+                        for (int threads : runOptions.threads) {
+                            for (const std::string& order : runOptions.orders) {
+                                onResult(runBenchmark(runOptions, scenario, size.first, size.second, threads, order));
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        // Untimed tiny runs of every configuration first, so code pages and one-time
+        // allocations are not charged to the peak memory of whichever run comes first
+        BenchmarkOptions warmupOptions = options;
+        warmupOptions.sizes = { { 64, 64 } };
+        warmupOptions.warmupTicks = 0;
+        warmupOptions.ticks = 2;
+        runAll(warmupOptions, [](const BenchmarkResult&) {});
+
+        runAll(options, report);
+
+        writeJson(options.jsonPath, options, results);
+        std::cout << "Results written to " << options.jsonPath << std::endl;
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[FATAL ERROR] Exception caught in benchmark: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
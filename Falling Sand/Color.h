@@ -0,0 +1,50 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Color.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Header file for the Color structure.
+//              A plain RGBA color used by the simulation core, so World and
+//              the Element classes build without the SFML graphics module.
+//              The Game converts it to sf::Color when drawing.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief 8-bit per channel RGBA color. Same layout and channel names as sf::Color.
+ */
+struct Color {
+    std::uint8_t r = 0;
+    std::uint8_t g = 0;
+    std::uint8_t b = 0;
+    std::uint8_t a = 255;
+
+    // **=== Constructors ===**
+
+    /** @brief Opaque black. */
+    constexpr Color() = default;
+
+    /**
+     * @brief Constructs a color from its channels.
+     * @param red Red channel.
+     * @param green Green channel.
+     * @param blue Blue channel.
+     * @param alpha Alpha channel (opaque by default).
+     */
+    constexpr Color(std::uint8_t red, std::uint8_t green, std::uint8_t blue, std::uint8_t alpha = 255)
+        : r(red), g(green), b(blue), a(alpha) {}
+
+    constexpr bool operator==(const Color& other) const = default;
+
+    // **=== Predefined Colors ===**
+    static const Color White;
+    static const Color Black;
+};
+
+inline constexpr Color Color::White{ 255, 255, 255 };
+inline constexpr Color Color::Black{ 0, 0, 0 };
\ No newline at end of file
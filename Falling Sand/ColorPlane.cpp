@@ -0,0 +1,91 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        ColorPlane.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Implementation file for the ColorPlane class.
+// ============================================================================
+
+#include "ColorPlane.h"
+#include "World.h"
+#include "JobSystem.h"
+#include "Trace.h"
+#include <algorithm>
+#include <stdexcept>
+
+static_assert(sizeof(Color) == 4, "ColorPlane hands its Colors to the texture as packed RGBA bytes.");
+
+// **=== Constructors ===**
+
+ColorPlane::ColorPlane(int rows, int cols) {
+    resize(rows, cols);
+}
+
+// **=== Public Methods ===**
+
+void ColorPlane::resize(int rows, int cols) {
+    if (rows < 0 || cols < 0) {
+        throw std::invalid_argument("ColorPlane dimensions (rows, cols) must not be negative.");
+    }
+    if (rows == m_rows && cols == m_cols) {
+        return;
+    }
+    m_rows = rows;
+    m_cols = cols;
+    m_pixels.assign(static_cast<std::size_t>(rows) * cols, EMPTY_COLOR);
+
+    // Water shading: 0.0 at the top row, 1.0 at the bottom one
+    m_waterRowColors.resize(rows);
+    for (int r = 0; r < rows; ++r) {
+        const float depthFactor = rows > 1 ? std::min(1.0f, static_cast<float>(r) / static_cast<float>(rows - 1)) : 0.0f;
+        auto blend = [depthFactor](std::uint8_t top, std::uint8_t bottom) {
+            return static_cast<std::uint8_t>(top + (bottom - top) * depthFactor);
+        };
+        m_waterRowColors[r] = Color(
+            blend(WATER_TOP_COLOR.r, WATER_BOTTOM_COLOR.r),
+            blend(WATER_TOP_COLOR.g, WATER_BOTTOM_COLOR.g),
+            blend(WATER_TOP_COLOR.b, WATER_BOTTOM_COLOR.b)
+        );
+    }
+}
+
+void ColorPlane::fill(const World& world, JobSystem& jobs) {
+    FS_TRACE_SCOPE("Fill Color Plane");
+    resize(world.getRows(), world.getCols());
+    jobs.parallelFor(0, m_rows, 8, [&](int begin, int end) {
+        fillRows(world, begin, end);
+    });
+}
+
+void ColorPlane::fillRows(const World& world, int rowBegin, int rowEnd) {
+    for (int r = rowBegin; r < rowEnd; ++r) {
+        fillSpan(world, r, 0, m_cols);
+    }
+}
+
+void ColorPlane::fillArea(const World& world, const DirtyRect& area) {
+    for (int r = area.minR; r <= area.maxR; ++r) {
+        fillSpan(world, r, area.minC, area.maxC + 1);
+    }
+}
+
+// **=== Private Methods ===**
+
+void ColorPlane::fillSpan(const World& world, int r, int colBegin, int colEnd) {
+    const ElementPtr* cells = &world.getGridState()[world.index(r, 0)];
+    Color* out = &m_pixels[static_cast<std::size_t>(r) * m_cols];
+    const Color waterColor = m_waterRowColors[r];
+    for (int c = colBegin; c < colEnd; ++c) {
+        const Element* element = cells[c].get();
+        if (!element) {
+            out[c] = EMPTY_COLOR;
+        }
+        else {
+            // A select, not a branch: sand and water are often mixed cell by cell
+            const Color color = element->getRenderColor();
+            out[c] = element->getType() == ParticleType::WATER ? waterColor : color;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        ColorPlane.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.1
+// Description: Header file for the ColorPlane class, one RGBA pixel per grid
+//              cell. The GridRenderer uploads it to a texture as is; it has
+//              no SFML dependency so it can be filled and benchmarked in the
+//              simulation core.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+#include "Color.h"
+#include "WorldChunk.h"
+
+class World;
+class JobSystem;
+
+/**
+ * @brief Row-major image of the World's grid, one Color per cell.
+ *
+ * Occupied cells get their element's render color, except water, which is
+ * shaded from light at the top of the grid to dark at the bottom (one color per
+ * row, looked up from a table built by resize()). Empty cells are transparent.
+ */
+class ColorPlane {
+public:
+    // **=== Constants ===**
+    /** @brief Color of empty cells. */
+    static constexpr Color EMPTY_COLOR{ 0, 0, 0, 0 };
+    /** @brief Water color on the top row. */
+    static constexpr Color WATER_TOP_COLOR{ 60, 120, 180 };
+    /** @brief Water color on the bottom row. */
+    static constexpr Color WATER_BOTTOM_COLOR{ 20, 40, 80 };
+
+    // **=== Constructors ===**
+
+    /** @brief Constructs an empty (0 x 0) plane. */
+    ColorPlane() = default;
+
+    /**
+     * @brief Constructs a transparent plane.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     */
+    ColorPlane(int rows, int cols);
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Resizes the plane (clearing it if the size changes) and rebuilds the water table.
+     * @param rows Number of rows.
+     * @param cols Number of columns.
+     * @throws std::invalid_argument if either dimension is negative.
+     */
+    void resize(int rows, int cols);
+
+    /**
+     * @brief Repaints every cell from the world, resizing to the world's grid first.
+     * Rows are spread over the job system.
+     * @param world The world to paint.
+     * @param jobs Job system to spread the rows over.
+     */
+    void fill(const World& world, JobSystem& jobs);
+
+    /**
+     * @brief Repaints rows [rowBegin, rowEnd) from the world. The plane must have the world's size.
+     * @param world The world to paint.
+     * @param rowBegin First row.
+     * @param rowEnd One past the last row.
+     */
+    void fillRows(const World& world, int rowBegin, int rowEnd);
+
+    /**
+     * @brief Repaints an inclusive area from the world. The plane must have the world's size.
+     * @param world The world to paint.
+     * @param area The cells to repaint, inside the grid (e.g. from World::takeChangedAreas()).
+     */
+    void fillArea(const World& world, const DirtyRect& area);
+
+    // **=== Public Getters ===**
+
+    int getRows() const { return m_rows; }
+    int getCols() const { return m_cols; }
+
+    /**
+     * @brief Gets one cell's color. No bounds checking.
+     * @return const Color& The color.
+     */
+    const Color& getPixel(int r, int c) const { return m_pixels[static_cast<std::size_t>(r) * m_cols + c]; }
+
+    /**
+     * @brief Gets the pixels as RGBA bytes, row-major (the layout sf::Texture::update() takes).
+     * @return const std::uint8_t* The first byte, or nullptr for an empty plane.
+     */
+    const std::uint8_t* getBytes() const { return m_pixels.empty() ? nullptr : &m_pixels.front().r; }
+
+    /**
+     * @brief Gets the water color of a row.
+     * @param r The row.
+     * @return const Color& The color.
+     */
+    const Color& getWaterColor(int r) const { return m_waterRowColors[r]; }
+
+private:
+    // **=== Private Members ===**
+    int m_rows = 0;
+    int m_cols = 0;
+    std::vector<Color> m_pixels;
+    /** @brief Water color of each row, so the gradient is not recomputed per cell. */
+    std::vector<Color> m_waterRowColors;
+
+    // **=== Private Methods ===**
+
+    /**
+     * @brief Repaints columns [colBegin, colEnd) of one row.
+     */
+    void fillSpan(const World& world, int r, int colBegin, int colEnd);
+};
\ No newline at end of file
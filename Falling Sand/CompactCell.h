@@ -0,0 +1,99 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        CompactCell.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Packed 32-bit cell encoding used by the CompactWorld. A cell
+//              is a plain value stored directly in the grid array: its type,
+//              a color variant, the awake flag, a claim stamp and a small
+//              per-type state field, so no element object is allocated.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+#include "ElementPalette.h"
+#include "Particle.h"
+
+/**
+ * @brief Bit layout of a CompactWorld cell and helpers to read and build one.
+ *
+ *  bits  0-7   ParticleType (0 = EMPTY, so an all-zero word is an empty cell)
+ *  bits  8-11  Color variant, an index into the type's ElementPalette row
+ *  bit   12    Awake: the cell is updated by the sweep
+ *  bits 13-14  Claim stamp: the epoch (1 to CLAIM_EPOCHS) of the tick in which the
+ *              cell last received an element, or 0. The cell is claimed while the
+ *              stamp equals the current tick's epoch, so claims need no clearing
+ *              at the end of a tick; a stale stamp is cleared when the sweep next
+ *              updates the cell, long before its epoch comes round again.
+ *  bit   15    Unused
+ *  bits 16-31  Per-type state (Dirt's time exposed, Grass's time covered)
+ */
+namespace CompactCell {
+
+    // **=== Types & Constants ===**
+
+    using Word = std::uint32_t;
+
+    inline constexpr Word TYPE_MASK = 0xFFu;
+    inline constexpr int VARIANT_SHIFT = 8;
+    inline constexpr Word VARIANT_MASK = 0xFu << VARIANT_SHIFT;
+    inline constexpr int VARIANT_COUNT = ElementPalette::VARIANT_COUNT;
+    inline constexpr Word AWAKE_BIT = 1u << 12;
+    inline constexpr int CLAIM_SHIFT = 13;
+    inline constexpr Word CLAIM_MASK = 0x3u << CLAIM_SHIFT;
+    /** @brief Distinct claim epochs; tick epochs cycle 1, 2, 3, 1, ... (0 is "never claimed"). */
+    inline constexpr int CLAIM_EPOCHS = 3;
+    static_assert(VARIANT_COUNT <= static_cast<int>((VARIANT_MASK >> VARIANT_SHIFT) + 1), "Variants must fit the variant bits.");
+    inline constexpr int STATE_SHIFT = 16;
+    inline constexpr Word STATE_MASK = 0xFFFFu << STATE_SHIFT;
+    inline constexpr int MAX_STATE = 0xFFFF;
+
+    /** @brief An empty cell. */
+    inline constexpr Word EMPTY = 0;
+
+    // **=== Accessors ===**
+
+    constexpr ParticleType getType(Word cell) { return static_cast<ParticleType>(cell & TYPE_MASK); }
+    constexpr bool isEmpty(Word cell) { return (cell & TYPE_MASK) == 0; }
+    constexpr int getVariant(Word cell) { return static_cast<int>((cell & VARIANT_MASK) >> VARIANT_SHIFT); }
+    constexpr bool isAwake(Word cell) { return (cell & AWAKE_BIT) != 0; }
+    constexpr int getClaimStamp(Word cell) { return static_cast<int>((cell & CLAIM_MASK) >> CLAIM_SHIFT); }
+    constexpr bool isClaimed(Word cell, int epoch) { return getClaimStamp(cell) == epoch; }
+    constexpr int getState(Word cell) { return static_cast<int>(cell >> STATE_SHIFT); }
+
+    // **=== Builders ===**
+
+    /**
+     * @brief Builds a new, awake cell with zero state.
+     * @param type The cell's ParticleType.
+     * @param variant The color variant, 0 to VARIANT_COUNT - 1.
+     * @return Word The cell.
+     */
+    constexpr Word make(ParticleType type, int variant) {
+        return static_cast<Word>(type) | (static_cast<Word>(variant) << VARIANT_SHIFT & VARIANT_MASK) | AWAKE_BIT;
+    }
+
+    /**
+     * @brief Stamps a cell as claimed in a tick.
+     * @param cell The cell.
+     * @param epoch The tick's claim epoch, 1 to CLAIM_EPOCHS.
+     * @return Word The claimed cell.
+     */
+    constexpr Word withClaim(Word cell, int epoch) {
+        return (cell & ~CLAIM_MASK) | (static_cast<Word>(epoch) << CLAIM_SHIFT);
+    }
+
+    /**
+     * @brief Replaces a cell's state field, clamped to MAX_STATE.
+     * @param cell The cell.
+     * @param state The new state (negative values are stored as 0).
+     * @return Word The updated cell.
+     */
+    constexpr Word withState(Word cell, int state) {
+        const Word clamped = static_cast<Word>(state < 0 ? 0 : (state > MAX_STATE ? MAX_STATE : state));
+        return (cell & ~STATE_MASK) | (clamped << STATE_SHIFT);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,324 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        CompactWorld.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.3
+// Description: Implementation file for the CompactWorld class.
+// ============================================================================
+
+#include "CompactWorld.h"
+#include "DirtElement.h"
+#include "ElementPalette.h"
+#include "ElementTraits.h"
+#include "GrassElement.h"
+#include "Trace.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using CompactCell::Word;
+
+// **=== Constructors & Destructors ===**
+
+CompactWorld::CompactWorld(int numRows, int numCols, std::uint64_t seed) : m_rows(numRows), m_cols(numCols), m_chunkRows(0), m_chunkCols(0) {
+    if (m_rows <= 0 || m_cols <= 0) {
+        throw std::invalid_argument("World dimensions (rows, cols) must be positive.");
+    }
+    m_cells.assign(static_cast<size_t>(m_rows) * m_cols, CompactCell::EMPTY);
+
+    m_chunkRows = (m_rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunkCols = (m_cols + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const size_t chunkCount = static_cast<size_t>(m_chunkRows) * m_chunkCols;
+    m_chunkActive.assign(chunkCount, 0);
+    m_chunkActiveNext.assign(chunkCount, 0);
+    m_chunkRandom.resize(chunkCount);
+    setSeed(seed);
+}
+
+// **=== Public Methods ===**
+
+void CompactWorld::update() {
+    FS_TRACE_SCOPE("CompactWorld::update");
+
+    // --- Step 0: Process Placement Requests ---
+    for (const PlacementRequest& request : m_placementRequests) {
+        if (isWithinBounds(request.r, request.c)) {
+            setElementByType(request.r, request.c, request.type);
+            wakeAround(request.r, request.c);
+        }
+    }
+    m_placementRequests.clear();
+
+    // --- Step 1: New claim epoch, and promote the chunks woken since the last sweep ---
+    // Every stamp from the last tick is now stale
+    m_claimEpoch = m_claimEpoch % CompactCell::CLAIM_EPOCHS + 1;
+    m_chunkActive.swap(m_chunkActiveNext);
+    std::fill(m_chunkActiveNext.begin(), m_chunkActiveNext.end(), std::uint8_t{ 0 });
+    m_activeChunkCount = static_cast<int>(std::count(m_chunkActive.begin(), m_chunkActive.end(), std::uint8_t{ 1 }));
+
+    // --- Step 2: Sweep bottom-up, alternating the column direction ---
+    for (int r = m_rows - 1; r >= 0; --r) {
+        const int chunkRowStart = (r / CHUNK_SIZE) * m_chunkCols;
+        for (int i = 0; i < m_chunkCols; ++i) {
+            const int cc = m_sweepRight ? i : m_chunkCols - 1 - i;
+            if (m_chunkActive[chunkRowStart + cc] && updateChunkRow(r, cc)) {
+                m_chunkActiveNext[chunkRowStart + cc] = 1; // Still has awake cells
+            }
+        }
+    }
+    m_sweepRight = !m_sweepRight;
+}
+
+void CompactWorld::setElementByType(int r, int c, ParticleType type) {
+    if (!isWithinBounds(r, c)) {
+        throw std::out_of_range("Coordinates [" + std::to_string(r) + "," + std::to_string(c) + "] are out of bounds in setElementByType.");
+    }
+    m_cells[index(r, c)] = type == ParticleType::EMPTY ? CompactCell::EMPTY : makeCell(type, r, c);
+    activateChunk(r, c);
+}
+
+void CompactWorld::requestPlacement(int r, int c, ParticleType type) {
+    m_placementRequests.push_back({ r, c, type });
+}
+
+void CompactWorld::setSeed(std::uint64_t seed) {
+    m_seed = seed;
+    for (size_t i = 0; i < m_chunkRandom.size(); ++i) {
+        m_chunkRandom[i].seed(seed, i); // One independent stream per chunk
+    }
+}
+
+// **=== Public Getters ===**
+
+Color CompactWorld::getCellColor(Word cell) {
+    return ElementPalette::getColor(CompactCell::getType(cell), CompactCell::getVariant(cell));
+}
+
+int CompactWorld::getAwakeCellCount() const {
+    return static_cast<int>(std::count_if(m_cells.begin(), m_cells.end(), [](Word cell) { return CompactCell::isAwake(cell); }));
+}
+
+std::size_t CompactWorld::getMemoryBytes() const {
+    return m_cells.capacity() * sizeof(Word)
+        + m_chunkActive.capacity() + m_chunkActiveNext.capacity()
+        + m_chunkRandom.capacity() * sizeof(Random)
+        + m_placementRequests.capacity() * sizeof(PlacementRequest);
+}
+
+// **=== Sweep ===**
+
+bool CompactWorld::updateChunkRow(int r, int chunkCol) {
+    const int rowStart = index(r, 0);
+    const int first = chunkCol * CHUNK_SIZE;
+    const int last = std::min(first + CHUNK_SIZE, m_cols) - 1;
+    const int step = m_sweepRight ? 1 : -1;
+    bool anyAwake = false;
+
+    for (int c = m_sweepRight ? first : last; c >= first && c <= last; c += step) {
+        const Word cell = m_cells[rowStart + c];
+        if (!CompactCell::isAwake(cell)) {
+            continue; // Empty or asleep
+        }
+        if (isClaimed(cell)) {
+            anyAwake = true; // Arrived this tick and has had its turn
+            continue;
+        }
+        if (cell & CompactCell::CLAIM_MASK) {
+            // Claimed last tick. Every claimed cell is awake in an active chunk (moves wake both
+            // ends, morphs make awake cells), so this clears each stamp the tick after it is set.
+            m_cells[rowStart + c] = cell & ~CompactCell::CLAIM_MASK;
+        }
+        switch (CompactCell::getType(cell)) {
+        case ParticleType::SAND:  updateSand(r, c); break;
+        case ParticleType::WATER: updateWater(r, c); break;
+        case ParticleType::DIRT:  updateDirt(r, c); break;
+        case ParticleType::GRASS: updateGrass(r, c); break;
+        default: m_cells[rowStart + c] &= ~CompactCell::AWAKE_BIT; break; // No behaviour yet
+        }
+        anyAwake |= CompactCell::isAwake(m_cells[rowStart + c]); // Empty if the cell moved away
+    }
+    return anyAwake;
+}
+
+// **=== Per-Type Updates ===**
+
+void CompactWorld::updateSand(int r, int c) {
+    // Same order as DynamicSolid::attemptFall(): down, sideways if sinking into water is blocked, then diagonals
+    bool moved = false;
+    if (r + 1 < m_rows) {
+        Random& rng = getRandom(r, c);
+        moved = tryMoveOrSwap(r, c, r + 1, c);
+        if (!moved && getElementType(r + 1, c) == ParticleType::WATER) {
+            const int dir = rng.nextDirection();
+            moved = tryMoveOrSwap(r, c, r, c + dir) || tryMoveOrSwap(r, c, r, c - dir);
+        }
+        if (!moved) {
+            const int dir = rng.nextDirection();
+            moved = tryMoveOrSwap(r, c, r + 1, c + dir) || tryMoveOrSwap(r, c, r + 1, c - dir);
+        }
+    }
+    if (!moved) {
+        m_cells[index(r, c)] &= ~CompactCell::AWAKE_BIT; // Resting sand sleeps until a neighbour moves
+    }
+}
+
+void CompactWorld::updateWater(int r, int c) {
+    // Same rules as Liquid::attemptFlow(); water never sleeps. There is no
+    // temperature in a cell, so water never boils here.
+
+    // --- Down, then the diagonals ---
+    if (tryMoveOrSwap(r, c, r + 1, c)) {
+        return;
+    }
+    Random& rng = getRandom(r, c);
+    const int diagDir = rng.nextDirection();
+    if (tryMoveOrSwap(r, c, r + 1, c + diagDir) || tryMoveOrSwap(r, c, r + 1, c - diagDir)) {
+        return;
+    }
+
+    // --- Sideways to the closest empty cell within the dispersion rate ---
+    const ElementTraits& traits = getElementTraits(ParticleType::WATER);
+    int bestC = c;
+    int minDist = traits.dispersionRate + 1;
+    int horizDir = rng.nextDirection();
+    for (int side = 0; side < 2; ++side) {
+        for (int step = 1; step <= traits.dispersionRate; ++step) {
+            const int checkC = c + horizDir * step;
+            if (!isWithinBounds(r, checkC)) {
+                break;
+            }
+            // Yield to anything denser above the target, and stop at claimed or occupied cells
+            const Word target = m_cells[index(r, checkC)];
+            if (isClaimed(target) || getElementTraits(getElementType(r - 1, checkC)).density > traits.density) {
+                break;
+            }
+            if (!CompactCell::isEmpty(target)) {
+                break;
+            }
+            if (step < minDist) {
+                minDist = step;
+                bestC = checkC;
+            }
+        }
+        if (minDist == 1) {
+            break;
+        }
+        horizDir = -horizDir;
+    }
+    if (bestC != c) {
+        tryMoveOrSwap(r, c, r, bestC);
+    }
+}
+
+void CompactWorld::updateDirt(int r, int c) {
+    // Same rules as DirtElement::update(), with the exposure timer in the state field
+    const int idx = index(r, c);
+    const ParticleType above = getElementType(r - 1, c);
+    if (above != ParticleType::EMPTY && above != ParticleType::GRASS) {
+        m_cells[idx] = CompactCell::withState(m_cells[idx], 0) & ~CompactCell::AWAKE_BIT; // Buried dirt sleeps
+        return;
+    }
+
+    Random& rng = getRandom(r, c);
+    int timeExposed = CompactCell::getState(m_cells[idx]) + 1;
+    if (timeExposed > DirtElement::GRASS_GROW_TIME_THRESHOLD) {
+        if (rng.chance(DirtElement::GRASS_GROW_CHANCE_PERCENT)) {
+            morphCell(r, c, ParticleType::GRASS);
+            return;
+        }
+        if (rng.nextInt(5) == 0) {
+            timeExposed = DirtElement::GRASS_GROW_TIME_THRESHOLD - rng.nextInt(10);
+        }
+    }
+    m_cells[idx] = CompactCell::withState(m_cells[idx], timeExposed);
+}
+
+void CompactWorld::updateGrass(int r, int c) {
+    // Same rules as GrassElement::update(), with the covered timer in the state field; grass never sleeps
+    const int idx = index(r, c);
+    const ParticleType above = getElementType(r - 1, c);
+    if (above == ParticleType::DIRT) {
+        morphCell(r, c, ParticleType::DIRT); // Buried by dirt: dies at once
+        return;
+    }
+    if (above == ParticleType::EMPTY) {
+        m_cells[idx] = CompactCell::withState(m_cells[idx], 0);
+        return;
+    }
+
+    const int timeCovered = CompactCell::getState(m_cells[idx]) + 1;
+    if (timeCovered > GrassElement::GRASS_DEATH_TIME_THRESHOLD && getRandom(r, c).chance(GrassElement::GRASS_DEATH_CHANCE_PERCENT)) {
+        morphCell(r, c, ParticleType::DIRT);
+        return;
+    }
+    m_cells[idx] = CompactCell::withState(m_cells[idx], timeCovered);
+}
+
+// **=== Cell Helpers ===**
+
+bool CompactWorld::tryMoveOrSwap(int r_from, int c_from, int r_to, int c_to) {
+    if (!isWithinBounds(r_to, c_to)) {
+        return false;
+    }
+    const int from = index(r_from, c_from);
+    const int to = index(r_to, c_to);
+    const Word mover = m_cells[from];
+    const Word target = m_cells[to];
+    if (isClaimed(target)) {
+        return false; // Already received an element this tick
+    }
+
+    // --- Case A: Target is Empty ---
+    if (CompactCell::isEmpty(target)) {
+        m_cells[to] = mover;
+        m_cells[from] = CompactCell::EMPTY;
+        claimCell(to);
+    }
+    // --- Case B: Swap with a lighter fluid ---
+    else {
+        const ElementTraits& moverTraits = getElementTraits(CompactCell::getType(mover));
+        const ElementTraits& targetTraits = getElementTraits(CompactCell::getType(target));
+        if (!targetTraits.isFluid() || moverTraits.density <= targetTraits.density) {
+            return false; // Blocked by a solid or an equally dense or denser fluid
+        }
+        m_cells[to] = mover;
+        m_cells[from] = target;
+        claimCell(to);
+        claimCell(from);
+    }
+    wakeAround(r_from, c_from);
+    wakeAround(r_to, c_to);
+    return true;
+}
+
+void CompactWorld::morphCell(int r, int c, ParticleType type) {
+    const int idx = index(r, c);
+    m_cells[idx] = CompactCell::make(type, CompactCell::getVariant(m_cells[idx])); // Same shade slot in the new type's palette
+    claimCell(idx); // It takes its first turn next tick
+}
+
+Word CompactWorld::makeCell(ParticleType type, int r, int c) const {
+    return CompactCell::make(type, ElementPalette::variantForSeed(ElementPalette::positionSeed(r, c)));
+}
+
+void CompactWorld::wakeAround(int r, int c) {
+    const int r0 = std::max(r - WAKE_RADIUS, 0);
+    const int r1 = std::min(r + WAKE_RADIUS, m_rows - 1);
+    const int c0 = std::max(c - WAKE_RADIUS, 0);
+    const int c1 = std::min(c + WAKE_RADIUS, m_cols - 1);
+    for (int wr = r0; wr <= r1; ++wr) {
+        Word* row = &m_cells[index(wr, 0)];
+        for (int wc = c0; wc <= c1; ++wc) {
+            if (!CompactCell::isEmpty(row[wc])) {
+                row[wc] |= CompactCell::AWAKE_BIT;
+            }
+        }
+    }
+    // The block is smaller than a chunk, so its corners cover every chunk it touches
+    activateChunk(r0, c0);
+    activateChunk(r0, c1);
+    activateChunk(r1, c0);
+    activateChunk(r1, c1);
+}
\ No newline at end of file
@@ -0,0 +1,221 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        CompactWorld.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.3
+// Description: Header file for the CompactWorld class, an alternative
+//              simulation engine whose grid holds packed 32-bit cells
+//              (see CompactCell.h) instead of pointers to Element objects.
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Color.h"
+#include "CompactCell.h"
+#include "Particle.h"
+#include "Random.h"
+#include "World.h"
+
+/**
+ * @brief Falling sand engine that stores every cell as one CompactCell::Word.
+ *
+ * The grid is a single row-major array of 32-bit words, so a 4096x4096 world
+ * takes 64 MB and reading a neighbour is a plain load. Element behaviour is
+ * the same as the Element classes' (sand falls and slides, water flows and
+ * spreads, dirt grows grass, grass dies when covered), written as one update
+ * function per type over cell words; per-element state that does not fit in
+ * the word (temperature, velocity, age) does not exist here.
+ *
+ * Like the World, the sweep goes bottom-up with the column direction
+ * alternating each tick, skips sleeping cells and CHUNK_SIZE x CHUNK_SIZE
+ * chunks without awake cells, and claims cells that receive an element so
+ * nothing moves twice in one tick. Unlike the World, it is single-threaded
+ * and wakes a moved cell's neighbours at once instead of on the next tick.
+ */
+class CompactWorld
+{
+public:
+    // **=== Constants ===**
+    /** @brief Width and height of a chunk in cells (same as the World's). */
+    static constexpr int CHUNK_SIZE = World::CHUNK_SIZE;
+
+    /** @brief Neighbourhood woken around both ends of a move (the 3x3 block). */
+    static constexpr int WAKE_RADIUS = 1;
+
+    // **=== Constructors & Destructors ===**
+
+    /**
+     * @brief Constructs an empty world.
+     * @param numRows The number of rows in the grid.
+     * @param numCols The number of columns in the grid.
+     * @param seed Seed of the random streams (see setSeed()).
+     */
+    CompactWorld(int numRows, int numCols, std::uint64_t seed = World::DEFAULT_SEED);
+
+    CompactWorld(const CompactWorld&) = delete;
+    CompactWorld& operator=(const CompactWorld&) = delete;
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Advances the simulation by one tick.
+     */
+    void update();
+
+    /**
+     * @brief Places an element (or clears the cell, for EMPTY) immediately.
+     * @param r Row index.
+     * @param c Column index.
+     * @param type The type to place.
+     * @throws std::out_of_range if the cell is outside the grid.
+     */
+    void setElementByType(int r, int c, ParticleType type);
+
+    /**
+     * @brief Queues an element placement for the start of the next update.
+     * @param r Row index.
+     * @param c Column index.
+     * @param type The type to place.
+     */
+    void requestPlacement(int r, int c, ParticleType type);
+
+    /**
+     * @brief Restarts every chunk's random stream from a seed.
+     * @param seed The seed.
+     */
+    void setSeed(std::uint64_t seed);
+
+    // **=== Public Getters ===**
+
+    int getRows() const { return m_rows; }
+    int getCols() const { return m_cols; }
+    std::uint64_t getSeed() const { return m_seed; }
+    bool isWithinBounds(int r, int c) const { return r >= 0 && r < m_rows && c >= 0 && c < m_cols; }
+
+    /**
+     * @brief Gets the raw cell word at a position.
+     * @return CompactCell::Word The cell, or CompactCell::EMPTY outside the grid.
+     */
+    CompactCell::Word getCell(int r, int c) const { return isWithinBounds(r, c) ? m_cells[index(r, c)] : CompactCell::EMPTY; }
+
+    /**
+     * @brief Gets the type at a position.
+     * @return ParticleType The type, or EMPTY outside the grid.
+     */
+    ParticleType getElementType(int r, int c) const { return CompactCell::getType(getCell(r, c)); }
+
+    /**
+     * @brief Gets the display color of a cell word.
+     * @param cell The cell.
+     * @return Color The type's ElementPalette color for the cell's variant.
+     */
+    static Color getCellColor(CompactCell::Word cell);
+
+    /**
+     * @brief Counts the awake cells (full scan, for reports and benchmarks).
+     * @return int The number of awake cells.
+     */
+    int getAwakeCellCount() const;
+
+    /**
+     * @brief Gets the number of chunks swept by the last tick.
+     * @return int The active chunk count.
+     */
+    int getActiveChunkCount() const { return m_activeChunkCount; }
+
+    /**
+     * @brief Gets the bytes held by the grid and its side tables.
+     * @return std::size_t The memory use.
+     */
+    std::size_t getMemoryBytes() const;
+
+private:
+    // **=== Private Members ===**
+    int m_rows;
+    int m_cols;
+    int m_chunkRows;
+    int m_chunkCols;
+    std::uint64_t m_seed = World::DEFAULT_SEED;
+    bool m_sweepRight = true;
+    int m_activeChunkCount = 0;
+
+    /** @brief The cells, row-major, no padding. */
+    std::vector<CompactCell::Word> m_cells;
+
+    /** @brief Chunks swept this tick (1 = active). */
+    std::vector<std::uint8_t> m_chunkActive;
+
+    /** @brief Chunks to sweep next tick; filled by wakes and by chunks that still have awake cells. */
+    std::vector<std::uint8_t> m_chunkActiveNext;
+
+    /** @brief One random stream per chunk, as in the World. */
+    std::vector<Random> m_chunkRandom;
+
+    /** @brief Claim epoch of the current tick (see CompactCell); advanced at the start of each tick. */
+    int m_claimEpoch = 1;
+
+    std::vector<PlacementRequest> m_placementRequests;
+
+    // **=== Private Methods ===**
+
+    int index(int r, int c) const { return r * m_cols + c; }
+    int chunkIndex(int r, int c) const { return (r / CHUNK_SIZE) * m_chunkCols + (c / CHUNK_SIZE); }
+    Random& getRandom(int r, int c) { return m_chunkRandom[chunkIndex(r, c)]; }
+
+    /**
+     * @brief Sweeps one row of one active chunk in the current direction.
+     * @return true if any cell of the row segment is still awake afterwards.
+     */
+    bool updateChunkRow(int r, int chunkCol);
+
+    // -- Per-Type Updates --
+    void updateSand(int r, int c);
+    void updateWater(int r, int c);
+    void updateDirt(int r, int c);
+    void updateGrass(int r, int c);
+
+    /**
+     * @brief Moves the cell at (r_from, c_from) into an empty target, or swaps it with a lighter fluid.
+     * Same rules as World::tryMoveOrSwap(): the target must be in bounds and unclaimed.
+     * @return true if the cell moved.
+     */
+    bool tryMoveOrSwap(int r_from, int c_from, int r_to, int c_to);
+
+    /**
+     * @brief Changes a cell's type in place and claims it for the rest of the tick.
+     * The state field starts fresh; the color variant is kept (as World::morphElement()
+     * keeps a shade).
+     */
+    void morphCell(int r, int c, ParticleType type);
+
+    /**
+     * @brief Builds a new cell whose color variant is hashed from its position
+     * (see ElementPalette); the variant then travels with the cell.
+     */
+    CompactCell::Word makeCell(ParticleType type, int r, int c) const;
+
+    /**
+     * @brief Stamps a cell as claimed for the rest of the tick.
+     */
+    void claimCell(int idx) { m_cells[idx] = CompactCell::withClaim(m_cells[idx], m_claimEpoch); }
+
+    /**
+     * @brief Checks if a cell received an element this tick.
+     */
+    bool isClaimed(CompactCell::Word cell) const { return CompactCell::isClaimed(cell, m_claimEpoch); }
+
+    /**
+     * @brief Wakes every occupied cell within WAKE_RADIUS and activates their chunks for the next tick.
+     */
+    void wakeAround(int r, int c);
+
+    /**
+     * @brief Marks the chunk holding a cell for the next tick.
+     */
+    void activateChunk(int r, int c) { m_chunkActiveNext[chunkIndex(r, c)] = 1; }
+};
\ No newline at end of file
@@ -3,8 +3,8 @@
 // File:        DirtElement.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-26
-// Last Update: 2025-04-27
-// Version:     1.3
+// Last Update: 2026-10-16
+// Version:     1.11
 // Description: Implementation file for the DirtElement class.
 //              Turns into grass if exposed within a random depth from the surface.
 // ============================================================================
@@ -12,8 +12,6 @@
 #include "DirtElement.h"
 #include "World.h"
 #include "Particle.h"
-#include <SFML/Graphics.hpp>
-#include <cstdlib>
 #include <memory>
 #include <iostream>
 
@@ -21,15 +19,13 @@
 
 // **=== Constructors ===**
 
-DirtElement::DirtElement() : m_timeSinceExposed(0) {
-	initializeColorVariation(getColor());
-}
+DirtElement::DirtElement() : StaticSolid(ParticleType::DIRT), m_timeSinceExposed(0) {}
 
 // **=== Overridden Public Methods ===**
 
 void DirtElement::update(World& world, int r, int c) {
     age++;
-    bool becameGrass = false;
+    Random& rng = world.getRandom(r, c);
 
     Element* elementAbove = world.getElement(r - 1, c);
     // Allow growth if air OR grass is directly above
@@ -39,18 +35,15 @@ void DirtElement::update(World& world, int r, int c) {
         m_timeSinceExposed++;
 
         if (m_timeSinceExposed > GRASS_GROW_TIME_THRESHOLD) {
-            if ((rand() % 100) < GRASS_GROW_CHANCE_PERCENT) {
-				// Create the grass element
-                std::unique_ptr<Element> newGrass = world.createElementByType(ParticleType::GRASS);
-                if (newGrass) {
-                    world.setNextElement(r, c, std::move(newGrass));
-                    becameGrass = true;
+            if (rng.chance(GRASS_GROW_CHANCE_PERCENT)) {
+                // Become grass in place. This object is gone afterwards, so stop here.
+                if (world.morphElement(r, c, ParticleType::GRASS)) {
+                    return;
                 }
-
             }
             // Reset timer slightly randomly
-            if (!becameGrass && (rand() % 5 == 0)) {
-                m_timeSinceExposed = GRASS_GROW_TIME_THRESHOLD - (rand() % 10);
+            if (rng.nextInt(5) == 0) {
+                m_timeSinceExposed = GRASS_GROW_TIME_THRESHOLD - rng.nextInt(10);
             }
         }
     }
@@ -58,28 +51,22 @@ void DirtElement::update(World& world, int r, int c) {
         m_timeSinceExposed = 0; // Reset timer if covered
     }
 
-    // --- Static Element Sleep & Update Mark ---
-    if (!becameGrass) {
-        if (!isEffectivelyExposed) {
-            // Consider uncommenting sleep for performance on buried dirt
-            // this->potentiallyGoToSleep();
-        }
-        else {
-            this->wakeUp();
-        }
-        this->markAsUpdated();
+    // --- Static Element Sleep ---
+    if (!isEffectivelyExposed) {
+        // Buried dirt sleeps so its chunk can sleep too; it is woken again
+        // by the World's wake requests when something above it moves away.
+        this->potentiallyGoToSleep();
+    }
+    else {
+        this->wakeUp();
     }
 }
-sf::Color DirtElement::getColor() const {
-    return sf::Color(133, 94, 66);
-}
-
-ParticleType DirtElement::getType() const {
-    return ParticleType::DIRT;
+Color DirtElement::getColor() const {
+    return getTraits().baseColor;
 }
 
 float DirtElement::getDensity() const {
-    return 1.7f; // Slightly denser than sand
+    return getTraits().density; // Slightly denser than sand
 }
 
 
@@ -94,14 +81,14 @@ float DirtElement::getThermalConductivity() const {
 }
 
 float DirtElement::getMeltingPoint() const {
-    return 1500.0f;
+    return getTraits().meltingPoint;
 }
 
 ParticleType DirtElement::getLiquidForm() const {
     // TODO: Add LAVA or MAGMA type later?
-    return ParticleType::EMPTY; // Placeholder
+    return getTraits().liquidForm; // Placeholder (EMPTY)
 }
 
 ParticleType DirtElement::getGasForm() const {
-    return ParticleType::EMPTY;
+    return getTraits().gasForm;
 }
\ No newline at end of file
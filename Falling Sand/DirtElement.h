@@ -3,8 +3,8 @@
 // File:        DirtElement.h
 // Author:      Foster Rae
 // Date Created:2025-04-26
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.7
 // Description: Header file for the DirtElement class. Represents dirt.
 //              Inherits from StaticSolid. Can turn into Grass if exposed
 //              within a certain random depth from the surface.
@@ -27,10 +27,23 @@ class World;
  */
 class DirtElement : public StaticSolid {
 public:
+    // **=== Constants ===**
+    // (Public so the CompactWorld's dirt follows the same rules)
+    /**
+     * @brief Minimum time (in ticks) required exposure to air before grass can potentially grow.
+     */
+    static constexpr int GRASS_GROW_TIME_THRESHOLD = 120;
+
+    /**
+     * @brief Chance (out of 100) per tick to grow grass once threshold and depth checks pass.
+     */
+    static constexpr int GRASS_GROW_CHANCE_PERCENT = 5;
+
     // **=== Constructors / Destructor ===**
 
     /**
-     * @brief Constructor, initializes exposure timer.
+     * @brief Constructor, initializes the exposure timer.
+     * (Its color variant is seeded by World::createElementByType(), see Element::seedColorVariant().)
     */
     DirtElement();
     /** @brief Default virtual destructor. */
@@ -48,15 +61,9 @@ public:
 
     /**
      * @brief Gets the display color for Dirt.
-     * @return sf::Color The color of dirt.
+     * @return Color The color of dirt.
      */
-    sf::Color getColor() const override;
-
-    /**
-     * @brief Gets the type identifier for Dirt.
-     * @return ParticleType The ParticleType::DIRT enum value.
-     */
-    ParticleType getType() const override;
+    Color getColor() const override;
 
     /**
      * @brief Gets the density of Dirt.
@@ -105,14 +112,4 @@ private:
      */
     int m_timeSinceExposed;
 
-    /**
-     * @brief Minimum time (in ticks) required exposure to air before grass can potentially grow.
-     */
-    static constexpr int GRASS_GROW_TIME_THRESHOLD = 120;
-
-    /**
-     * @brief Chance (out of 100) per tick to grow grass once threshold and depth checks pass.
-     */
-    static constexpr int GRASS_GROW_CHANCE_PERCENT = 5;
-
 };
\ No newline at end of file
@@ -3,8 +3,8 @@
 // File:        DynamicSolid.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-25
-// Version:     1.5
+// Last Update: 2026-10-16
+// Version:     1.7
 // Description: Implementation file for the DynamicSolid abstract class.
 //              Contains common logic shared by dynamic solid elements,
 //              primarily the gravity-driven falling behaviour.
@@ -15,7 +15,6 @@
 #include "Liquid.h"      // Need Liquid definition for type checking/casting
 #include "Gas.h"         // Need Gas definition for type checking/casting (and density later)
 #include "Particle.h"    // For ParticleType::EMPTY
-#include <cstdlib>       // For rand()
 #include <memory>        // For std::unique_ptr comparisons if needed
 #include <utility>       // For std::move if transferring ownership
 
@@ -25,7 +24,7 @@
  * @brief Attempts to perform standard dynamic solid falling logic.
  * Checks below, then potentially diagonally below (if canSlideDiagonally() is true),
  * attempting to move into empty space or displace lighter liquids/gases.
- * Interacts with the World's nextGrid state.
+ * Moves are claimed in the World for the rest of the tick.
  * @param world Reference to the world grid and its methods.
  * @param r Current row.
  * @param c Current column.
@@ -56,7 +55,7 @@ bool DynamicSolid::attemptFall(World& world, int r, int c) {
     bool tried_horizontal = false;
     if (self->getType() == ParticleType::SAND && element_below && element_below->getType() == ParticleType::WATER) {
         tried_horizontal = true; // Mark that we tried this special path
-        int h_dir = (rand() % 2 == 0) ? 1 : -1; // Randomize L/R
+        int h_dir = world.getRandom(r, c).nextDirection(); // Randomize L/R
 
         // Try moving horizontally LEFT/RIGHT into EMPTY or WATER
         if (world.tryMoveOrSwap(r, c, r, c + h_dir)) { // Try first horizontal dir
@@ -71,7 +70,7 @@ bool DynamicSolid::attemptFall(World& world, int r, int c) {
     // --- Priority 2/3: Try Move/Swap Diagonals Down ---
     // (Only if downward failed, and potentially after horizontal check for Sand-on-Water)
     if (this->canSlideDiagonally()) {
-        int diag_dir = (rand() % 2 == 0) ? 1 : -1;
+        int diag_dir = world.getRandom(r, c).nextDirection();
 
         if (world.tryMoveOrSwap(r, c, r_below, c + diag_dir)) { // Try first diagonal dir
             return true;
@@ -3,8 +3,8 @@
 // File:        DynamicSolid.h
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-25
-// Version:     1.2
+// Last Update: 2026-10-16
+// Version:     1.4
 // Description: Header file for the DynamicSolid abstract class.
 //              Inherits from Solid and serves as a base for solid elements
 //              that are typically affected by gravity and can move
@@ -28,14 +28,20 @@ class World;
  */
 class DynamicSolid : public Solid {
 public:
-    // **=== Destructor ===**
+    // **=== Constructors & Destructor ===**
+
+    /**
+     * @brief Constructs a dynamic solid element.
+     * @param type The concrete element's ParticleType.
+     */
+    explicit DynamicSolid(ParticleType type) : Solid(type) {}
+
     virtual ~DynamicSolid() = default;
 
 
     // **=== Pure Virtual Public Methods (Inherited from Solid) ===**
     virtual void update(World& world, int r, int c) = 0;
-    virtual sf::Color getColor() const = 0;
-    virtual ParticleType getType() const = 0;
+    virtual Color getColor() const = 0;
     virtual float getDensity() const = 0;
     virtual float getHardness() const = 0;
     virtual float getThermalConductivity() const = 0;
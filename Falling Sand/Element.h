@@ -3,8 +3,8 @@
 // File:        Element.h
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-26
-// Version:     1.5
+// Last Update: 2026-10-16
+// Version:     1.14
 // Description: Header file for the Element abstract base class.
 //              Defines the common interface and fundamental properties
 //              (temperature, velocity, age, simulation flags)
@@ -13,12 +13,29 @@
 
 #pragma once
 
-#include <SFML/Graphics.hpp>
+#include "Color.h"
+#include "ElementPalette.h"
+#include "ElementTraits.h"
 #include "Particle.h"
-#include <cstdlib>
-#include <algorithm>
+#include <cstdint>
+#include <memory>
 
 class World;
+class ElementPool;
+class Element;
+
+/**
+ * @brief Deleter for owning Element pointers.
+ * Returns pooled elements to their ElementPool, and deletes any others normally.
+ */
+struct ElementDeleter {
+    void operator()(Element* element) const noexcept;
+};
+
+/**
+ * @brief Owning pointer to an Element. Used for every cell of the World's grids.
+ */
+using ElementPtr = std::unique_ptr<Element, ElementDeleter>;
 
 /**
  * @brief Abstract base class for all simulated elements (particles) in the world.
@@ -29,7 +46,14 @@ public:
     // **=== Constants ===**
 	static constexpr float DEFAULT_TEMPERATURE = 20.0f; // Default temperature in Celsius
 
-    // **=== Destructor ===**
+    // **=== Constructors & Destructor ===**
+
+    /**
+     * @brief Constructs an element.
+     * @param type The concrete element's ParticleType. It never changes, so it is
+     * stored here and getType() needs no virtual call.
+     */
+    explicit Element(ParticleType type) : m_type(type) {}
 
     /**
      * @brief Virtual destructor.
@@ -48,22 +72,41 @@ public:
 
     /**
      * @brief Gets the display color of this element.
-     * @return sf::Color The color used to draw this element.
+     * @return Color The color used to draw this element.
      */
-    virtual sf::Color getColor() const = 0;
+    virtual Color getColor() const = 0;
 
     /**
      * @brief Gets the specific type identifier for this element.
      * @return ParticleType The enum value representing the specific kind of element.
      */
-    virtual ParticleType getType() const = 0;
+    ParticleType getType() const { return m_type; }
+
+    /**
+     * @brief Gets the static properties of this element's type (density, phase, ...).
+     * Hot paths use this instead of casting to Solid/Liquid/Gas for their virtual getters.
+     * @return const ElementTraits& The type's row of ELEMENT_TRAITS.
+     */
+    const ElementTraits& getTraits() const { return getElementTraits(m_type); }
+
+    /**
+     * @brief Gets the color for rendering this specific particle: the variant of its type's
+     * palette chosen when it was created (see seedColorVariant()).
+     * @return Color The particle's color.
+     */
+    Color getRenderColor() const {
+        return ElementPalette::getColor(m_type, m_colorVariant);
+    }
 
     /**
-     * @brief Gets the unique, potentially varied color for rendering this specific particle.
-     * @return sf::Color The color stored in m_variedColor.
+     * @brief Picks this particle's color variant by hashing the cell it is created in.
+     * The variant then travels with the particle, so the same world renders the same
+     * every run regardless of where the pools place elements.
+     * @param r The row the element is created in.
+     * @param c The column the element is created in.
      */
-    sf::Color getRenderColor() const {
-        return m_variedColor;
+    void seedColorVariant(int r, int c) {
+        m_colorVariant = static_cast<std::uint8_t>(ElementPalette::variantForSeed(ElementPalette::positionSeed(r, c)));
     }
 
 
@@ -94,58 +137,59 @@ public:
         return -1; // Default: infinite lifetime
     }
 
+    // Sleep flag accessors are not virtual: the sweep reads them for every cell.
+
     /**
      * @brief Checks if the element is currently considered "awake".
      * @return true if the element is awake, false otherwise.
      */
-    virtual bool isAwake() const {
+    bool isAwake() const {
         return awake;
     }
 
     /**
      * @brief Wakes the element up.
      */
-    virtual void wakeUp() {
+    void wakeUp() {
         awake = true;
     }
 
     /**
      * @brief Allows the element to potentially go to sleep if its state is stable.
      */
-    virtual void potentiallyGoToSleep() {
+    void potentiallyGoToSleep() {
         if (velocity_x == 0.0f && velocity_y == 0.0f) {
             awake = false;
         }
     }
 
+    // **=== Type Changes ===**
+
     /**
-     * @brief Checks if this element has already been updated in the current simulation tick.
-     * Useful for preventing double updates.
-     * @return true if the element's final state for this tick has been determined, false otherwise.
+     * @brief What an element passes on when it changes type (see World::morphElement()).
      */
-    virtual bool isUpdatedThisTick() const {
-        return updatedThisTick;
-    }
+    struct MorphState {
+        float temperature;
+        std::uint8_t colorVariant; // Keeps the shade, so a dirt cell turning into grass does not flicker
+    };
 
     /**
-     * @brief Marks this element as having been updated for the current simulation tick.
-     * Should be called by the update logic once the element's final state/position
-	 * for the tick is determined and written to the next grid.
+     * @brief Captures the state a new element of another type should inherit from this one.
+     * @return MorphState The state.
      */
-    virtual void markAsUpdated() {
-        updatedThisTick = true;
+    MorphState getMorphState() const {
+        return { temperature, m_colorVariant };
     }
 
     /**
-     * @brief Resets the update flag for the element.
-     * Should be called on all elements at the very beginning of each simulation tick,
-     * before any update logic runs.
+     * @brief Takes over the state of the element this one replaced.
+     * @param previous The replaced element's state.
      */
-    virtual void resetUpdateFlag() {
-        updatedThisTick = false;
+    void inheritMorphState(const MorphState& previous) {
+        temperature = previous.temperature;
+        m_colorVariant = previous.colorVariant;
     }
 
-
 protected:
     // **=== Protected Members ===**
     int age = 0;
@@ -162,40 +206,20 @@ protected:
 	 * If false, the element will not be updated in the simulation.
 	 */
     bool awake = true;
-    /**
-     * @brief Flag indicating if the element's state for the current tick has been finalized.
-     * Reset at the start of each tick, set to true when update is complete for this element.
-     */
-    bool updatedThisTick = false;
 
-    /**
-	 * @brief Unique color for rendering this specific particle.
-     */
-    sf::Color m_variedColor;
+private:
+    // **=== Private Members ===**
+    friend class ElementPool;
+    friend struct ElementDeleter;
+
+    /** @brief The concrete element's type, set once by the constructor. */
+    ParticleType m_type;
 
-    // **=== Protected Helper Methods ===**
+    /** @brief Index into the type's palette (see ElementPalette); sits in padding before m_pool. */
+    std::uint8_t m_colorVariant = 0;
 
     /**
-     * @brief Calculates a random variation based on a base color and stores it.
-     * Should be called by derived class constructors.
-     * @param baseColor The base color for the element type.
+     * @brief The pool this element's storage came from, or nullptr if it was heap allocated.
      */
-    void initializeColorVariation(sf::Color baseColor) {
-        // --- Adjust the variation range as desired ---
-        int variation = 5; // Max +/- change for R, G, B
-        int r_offset = (rand() % (variation * 2 + 1)) - variation; // -variation to +variation
-        int g_offset = (rand() % (variation * 2 + 1)) - variation;
-        int b_offset = (rand() % (variation * 2 + 1)) - variation;
-
-        // Clamp values between 0 and 255
-        int r = std::min(255, std::max(0, static_cast<int>(baseColor.r) + r_offset));
-        int g = std::min(255, std::max(0, static_cast<int>(baseColor.g) + g_offset));
-        int b = std::min(255, std::max(0, static_cast<int>(baseColor.b) + b_offset));
-
-        m_variedColor = sf::Color(  
-           static_cast<std::uint8_t>(r),  
-           static_cast<std::uint8_t>(g),  
-           static_cast<std::uint8_t>(b)
-        );
-    }
+    ElementPool* m_pool = nullptr;
 };
\ No newline at end of file
@@ -0,0 +1,108 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        ElementPalette.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.1
+// Description: Compile-time table of every type's color variants. A
+//              particle's variant is picked once, by hashing the cell it
+//              is created in, so elements store a one-byte index rather
+//              than a color and draw no random numbers for one.
+// ============================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Color.h"
+#include "ElementTraits.h"
+#include "Particle.h"
+
+namespace ElementPalette {
+
+    // **=== Constants ===**
+
+    /** @brief Color variants per type (a power of two, so a variant is a hash's top bits). */
+    inline constexpr int VARIANT_COUNT = 16;
+    inline constexpr int VARIANT_BITS = 4;
+    static_assert(VARIANT_COUNT == 1 << VARIANT_BITS, "VARIANT_COUNT must be 2^VARIANT_BITS.");
+
+    /** @brief Largest shift of one channel from the type's base color. */
+    inline constexpr int MAX_CHANNEL_OFFSET = 5;
+
+    // **=== Hashing ===**
+
+    /**
+     * @brief Scrambles a seed (the SplitMix64 finaliser); nearby seeds give unrelated results.
+     * @param x The seed.
+     * @return std::uint64_t The hash.
+     */
+    constexpr std::uint64_t mix(std::uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+
+    /**
+     * @brief Picks a variant for a seed.
+     * @param seed A deterministic per-particle value, such as positionSeed().
+     * @return int The variant, 0 to VARIANT_COUNT - 1.
+     */
+    constexpr int variantForSeed(std::uint64_t seed) {
+        return static_cast<int>(mix(seed) >> (64 - VARIANT_BITS));
+    }
+
+    /**
+     * @brief Seed of a cell position, for a particle created there.
+     * @param r The row.
+     * @param c The column.
+     * @return std::uint64_t The seed.
+     */
+    constexpr std::uint64_t positionSeed(int r, int c) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(r)) << 32) | static_cast<std::uint32_t>(c);
+    }
+
+    // **=== Palette Table ===**
+
+    using Palette = std::array<std::array<Color, VARIANT_COUNT>, PARTICLE_TYPE_COUNT>;
+
+    /**
+     * @brief Builds the table: each solid's base color with every channel shifted by up to
+     * +/-MAX_CHANNEL_OFFSET. Liquids and gases keep their uniform base color.
+     */
+    constexpr Palette buildPalette() {
+        Palette palette{};
+        for (std::size_t t = 0; t < PARTICLE_TYPE_COUNT; ++t) {
+            const ElementTraits& traits = ELEMENT_TRAITS[t];
+            for (std::size_t v = 0; v < VARIANT_COUNT; ++v) {
+                Color color = traits.baseColor;
+                if (traits.phase == MatterPhase::Solid) {
+                    const std::uint64_t bits = mix(t * VARIANT_COUNT + v + 1);
+                    auto vary = [bits](std::uint8_t channel, int shift) {
+                        const int offset = static_cast<int>((bits >> shift) % (2 * MAX_CHANNEL_OFFSET + 1)) - MAX_CHANNEL_OFFSET;
+                        const int value = channel + offset;
+                        return static_cast<std::uint8_t>(value < 0 ? 0 : (value > 255 ? 255 : value));
+                    };
+                    color = Color(vary(color.r, 0), vary(color.g, 16), vary(color.b, 32));
+                }
+                palette[t][v] = color;
+            }
+        }
+        return palette;
+    }
+
+    /** @brief Every type's variants, indexed [type][variant]. */
+    inline constexpr Palette PALETTE = buildPalette();
+
+    /**
+     * @brief Gets one variant of a type's color.
+     * @param type The ParticleType.
+     * @param variant The variant, 0 to VARIANT_COUNT - 1.
+     * @return const Color& The color.
+     */
+    constexpr const Color& getColor(ParticleType type, int variant) {
+        return PALETTE[static_cast<std::size_t>(type)][static_cast<std::size_t>(variant)];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        ElementPool.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Implementation file for the ElementPool class and the
+//              ElementDeleter used by ElementPtr.
+// ============================================================================
+
+#include "ElementPool.h"
+#include "AlignedAllocator.h"
+#include <algorithm>
+#include <new>
+
+// **=== Element Deleter ===**
+
+void ElementDeleter::operator()(Element* element) const noexcept {
+    if (!element) {
+        return;
+    }
+    if (element->m_pool) {
+        element->m_pool->release(element); // Pooled: destroy in place and recycle the slot
+    }
+    else {
+        delete element;                    // Not pooled: plain heap object
+    }
+}
+
+// **=== Constructors & Destructors ===**
+
+ElementPool::ElementPool(ParticleType type, std::size_t slotSize, std::size_t slotAlign, std::size_t slotsPerSlab)
+    : m_type(type),
+      m_slotAlign(std::max(slotAlign, alignof(FreeSlot))),
+      m_slotsPerSlab(std::max<std::size_t>(slotsPerSlab, 1))
+{
+    // Round the slot size up so every slot in a slab stays correctly aligned
+    std::size_t size = std::max(slotSize, sizeof(FreeSlot));
+    m_slotSize = (size + m_slotAlign - 1) / m_slotAlign * m_slotAlign;
+}
+
+ElementPool::~ElementPool() {
+    const std::size_t slabAlign = std::max(m_slotAlign, CACHE_LINE_SIZE);
+    for (void* slab : m_slabs) {
+        ::operator delete(slab, std::align_val_t{ slabAlign });
+    }
+}
+
+// **=== Public Methods ===**
+
+void ElementPool::release(Element* element) noexcept {
+    if (m_census) {
+        m_census->remove(element->getType()); // Not necessarily m_type, if the element was morphed
+    }
+    element->~Element();
+    recycle(element);
+}
+
+void ElementPool::reserve(std::size_t slotCount) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    while (m_capacity < slotCount) {
+        grow();
+    }
+}
+
+ElementPoolStats ElementPool::getStats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    ElementPoolStats stats;
+    stats.type = m_type;
+    stats.capacity = m_capacity;
+    stats.inUse = m_census ? m_census->getLive(m_type) : m_inUse;
+    stats.peakInUse = m_census ? m_census->getPeak(m_type) : m_peakInUse;
+    stats.slotsInUse = m_inUse;
+    stats.slabCount = m_slabs.size();
+    return stats;
+}
+
+// **=== Private Methods ===**
+
+void* ElementPool::acquire() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_freeList) {
+        grow();
+    }
+    FreeSlot* slot = m_freeList;
+    m_freeList = slot->next;
+
+    ++m_inUse;
+    m_peakInUse = std::max(m_peakInUse, m_inUse);
+    return slot;
+}
+
+void ElementPool::recycle(void* slot) noexcept {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    pushFree(slot);
+    --m_inUse;
+}
+
+void ElementPool::pushFree(void* slot) noexcept {
+    FreeSlot* freeSlot = ::new (slot) FreeSlot{ m_freeList };
+    m_freeList = freeSlot;
+}
+
+void ElementPool::grow() {
+    const std::size_t slabAlign = std::max(m_slotAlign, CACHE_LINE_SIZE);
+    m_slabs.reserve(m_slabs.size() + 1); // Reserve first so push_back below cannot throw and leak the slab
+    auto* slab = static_cast<unsigned char*>(::operator new(m_slotSize * m_slotsPerSlab, std::align_val_t{ slabAlign }));
+    m_slabs.push_back(slab);
+
+    // Thread slots onto the free list back-to-front so they are handed out in address order
+    for (std::size_t i = m_slotsPerSlab; i > 0; --i) {
+        pushFree(slab + (i - 1) * m_slotSize);
+    }
+    m_capacity += m_slotsPerSlab;
+}
\ No newline at end of file
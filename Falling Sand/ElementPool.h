@@ -0,0 +1,254 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        ElementPool.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.3
+// Description: Header file for the ElementPool class.
+//              A slab / free-list allocator for Element objects of a single
+//              ParticleType. Elements are constructed in place in pooled
+//              slots and the slot is recycled when the element is destroyed,
+//              so steady-state simulation does no global heap allocation.
+//              Also the ElementCensus, which counts live elements per type
+//              across a World's pools.
+// ============================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Particle.h"
+#include "Element.h"
+
+/**
+ * @brief Snapshot of the occupancy counters of an ElementPool.
+ */
+struct ElementPoolStats {
+    ParticleType type = ParticleType::EMPTY;
+    std::size_t capacity = 0;    // Total slots across all slabs
+    std::size_t inUse = 0;       // Live elements of the type (counted by the census, if the pool has one)
+    std::size_t peakInUse = 0;   // Highest inUse value seen
+    std::size_t slotsInUse = 0;  // Slots currently holding a live element of any type (see ElementPool::morph())
+    std::size_t slabCount = 0;   // Number of slabs allocated from the global heap
+};
+
+/**
+ * @brief Live element counts per ParticleType, shared by the pools of one World.
+ *
+ * A slot stays with the pool that allocated it, but after ElementPool::morph()
+ * it holds an element of another type, so a pool's slot count is not the
+ * number of elements of its type. Pools given a census (see
+ * ElementPool::setCensus()) count every element they construct, morph or
+ * release here, by the element's type. Thread-safe.
+ */
+class ElementCensus {
+public:
+    /**
+     * @brief Counts a new live element.
+     * @param type The element's type.
+     */
+    void add(ParticleType type) {
+        const std::size_t live = m_live[static_cast<std::size_t>(type)].fetch_add(1, std::memory_order_relaxed) + 1;
+        std::atomic<std::size_t>& peak = m_peak[static_cast<std::size_t>(type)];
+        std::size_t current = peak.load(std::memory_order_relaxed);
+        while (live > current && !peak.compare_exchange_weak(current, live, std::memory_order_relaxed)) {}
+    }
+
+    /**
+     * @brief Stops counting an element (destroyed, or morphed into another type).
+     * @param type The element's type.
+     */
+    void remove(ParticleType type) { m_live[static_cast<std::size_t>(type)].fetch_sub(1, std::memory_order_relaxed); }
+
+    std::size_t getLive(ParticleType type) const { return m_live[static_cast<std::size_t>(type)].load(std::memory_order_relaxed); }
+    std::size_t getPeak(ParticleType type) const { return m_peak[static_cast<std::size_t>(type)].load(std::memory_order_relaxed); }
+
+private:
+    std::array<std::atomic<std::size_t>, PARTICLE_TYPE_COUNT> m_live{};
+    std::array<std::atomic<std::size_t>, PARTICLE_TYPE_COUNT> m_peak{};
+};
+
+/**
+ * @brief Fixed-size slot allocator for the elements of one ParticleType.
+ *
+ * Memory is requested from the global heap in large slabs. Free slots are
+ * threaded onto an intrusive singly linked free list, so acquire/release are
+ * O(1) pointer swaps. Slabs are only returned to the heap when the pool dies.
+ *
+ * Acquire and release take a (normally uncontended) lock so elements can be
+ * created and destroyed from the World's parallel chunk update.
+ */
+class ElementPool {
+public:
+    // **=== Constants ===**
+    static constexpr std::size_t DEFAULT_SLOTS_PER_SLAB = 4096;
+
+    // **=== Constructors & Destructors ===**
+
+    /**
+     * @brief Constructs an empty pool. No memory is allocated until the first acquire.
+     * @param type The ParticleType this pool serves (for stats/debugging).
+     * @param slotSize Size in bytes of the element type stored in the pool.
+     * @param slotAlign Alignment in bytes of the element type stored in the pool.
+     * @param slotsPerSlab Number of slots allocated at a time when the pool grows.
+     */
+    ElementPool(ParticleType type, std::size_t slotSize, std::size_t slotAlign, std::size_t slotsPerSlab = DEFAULT_SLOTS_PER_SLAB);
+
+    /**
+     * @brief Frees all slabs. All elements from this pool must already be destroyed.
+     */
+    ~ElementPool();
+
+    ElementPool(const ElementPool&) = delete;
+    ElementPool& operator=(const ElementPool&) = delete;
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Constructs an element of type T in a pooled slot.
+     * @tparam T The concrete Element subclass. Must fit the pool's slot size/alignment.
+     * @param args Constructor arguments forwarded to T.
+     * @return T* The new element, owned by the caller (release through ElementDeleter).
+     */
+    template <typename T, typename... Args>
+    T* construct(Args&&... args) {
+        static_assert(std::is_base_of_v<Element, T>, "ElementPool only stores Element subclasses.");
+        void* slot = acquire();
+        T* element = nullptr;
+        try {
+            element = ::new (slot) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            recycle(slot);
+            throw;
+        }
+        element->m_pool = this;
+        if (m_census) {
+            m_census->add(element->getType());
+        }
+        return element;
+    }
+
+    /**
+     * @brief Turns a pooled element into another Element subclass in the same slot.
+     * The old element is destroyed and T is constructed in its storage, which stays
+     * with the old element's pool. No slot is acquired or released, so this takes no lock;
+     * the pool's census, if any, moves the element from the old type's count to the new one's.
+     * @tparam T The new concrete Element subclass.
+     * @param element The element to change. Must not be used afterwards if this succeeds.
+     * @param args Constructor arguments forwarded to T.
+     * @return T* The new element, or nullptr (element untouched) if the element is not
+     * pooled or T does not fit its slot. If T's constructor throws, the slot is recycled.
+     */
+    template <typename T, typename... Args>
+    static T* morph(Element* element, Args&&... args) {
+        static_assert(std::is_base_of_v<Element, T>, "ElementPool only stores Element subclasses.");
+        ElementPool* pool = element->m_pool;
+        if (!pool || sizeof(T) > pool->m_slotSize || pool->m_slotAlign % alignof(T) != 0) {
+            return nullptr;
+        }
+        void* slot = element;
+        if (pool->m_census) {
+            pool->m_census->remove(element->getType());
+        }
+        element->~Element();
+        T* morphed = nullptr;
+        try {
+            morphed = ::new (slot) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            pool->recycle(slot);
+            throw;
+        }
+        morphed->m_pool = pool;
+        if (pool->m_census) {
+            pool->m_census->add(morphed->getType());
+        }
+        return morphed;
+    }
+
+    /**
+     * @brief Destroys a pooled element and returns its slot to the free list.
+     * @param element The element to destroy. Must have been constructed by this pool.
+     */
+    void release(Element* element) noexcept;
+
+    /**
+     * @brief Sets the census that counts this pool's elements by type. Call before the first construct().
+     * @param census The census (shared by the pools of one World and outliving their elements), or nullptr.
+     */
+    void setCensus(ElementCensus* census) { m_census = census; }
+
+    /**
+     * @brief Makes sure at least the given number of slots are available without growing later.
+     * @param slotCount Desired total capacity.
+     */
+    void reserve(std::size_t slotCount);
+
+    /**
+     * @brief Gets the occupancy counters of this pool. inUse and peakInUse come from the
+     * census if there is one, and are the slot counts otherwise.
+     * @return ElementPoolStats The current stats.
+     */
+    ElementPoolStats getStats() const;
+
+private:
+    // **=== Private Types ===**
+    /** @brief Overlay stored in free slots to link them together. */
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    // **=== Private Members ===**
+    /** @brief Guards the free list, slabs and counters. */
+    mutable std::mutex m_mutex;
+
+    ParticleType m_type;
+    std::size_t m_slotSize;
+    std::size_t m_slotAlign;
+    std::size_t m_slotsPerSlab;
+
+    /** @brief Head of the intrusive free list. */
+    FreeSlot* m_freeList = nullptr;
+    /** @brief Every slab allocated so far (freed in the destructor). */
+    std::vector<void*> m_slabs;
+    /** @brief Counts elements by type across pools; nullptr if not counted. */
+    ElementCensus* m_census = nullptr;
+
+    // -- Counters --
+    std::size_t m_capacity = 0;
+    std::size_t m_inUse = 0;
+    std::size_t m_peakInUse = 0;
+
+    // **=== Private Methods ===**
+
+    /**
+     * @brief Pops a free slot, allocating a new slab if the free list is empty.
+     * @return void* Uninitialised storage for one element.
+     */
+    void* acquire();
+
+    /**
+     * @brief Returns an unused slot to the pool (locks).
+     * @param slot The slot to recycle.
+     */
+    void recycle(void* slot) noexcept;
+
+    /**
+     * @brief Pushes a slot back onto the free list. Caller must hold m_mutex.
+     * @param slot The slot to recycle.
+     */
+    void pushFree(void* slot) noexcept;
+
+    /**
+     * @brief Allocates a new slab and threads its slots onto the free list. Caller must hold m_mutex.
+     */
+    void grow();
+};
\ No newline at end of file
@@ -0,0 +1,36 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        ElementRegistry.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Registry of the ParticleTypes that have an element class.
+//              The World generates its pools, its element factory and its
+//              type-indexed update dispatch from this one list, so adding an
+//              element class is a single line here.
+// ============================================================================
+
+#pragma once
+
+#include "SandElement.h"
+#include "DirtElement.h"
+#include "GrassElement.h"
+#include "WaterElement.h"
+
+// **=== Element Class Registry ===**
+
+/**
+ * @brief Calls X(TYPE, Class) for every ParticleType with an element class.
+ *
+ * The World's update dispatch calls Class::update() directly (not through the
+ * vtable) for elements of TYPE. A subclass used for the same type (such as the
+ * micro benchmarks' FlowWater) may override the virtual property getters, but
+ * its update() override would be skipped.
+ */
+#define FS_FOR_EACH_ELEMENT_CLASS(X) \
+    X(SAND, SandElement)             \
+    X(DIRT, DirtElement)             \
+    X(GRASS, GrassElement)           \
+    X(WATER, WaterElement)
+    // **=== Add new element classes above ===**
\ No newline at end of file
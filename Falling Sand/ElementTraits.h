@@ -0,0 +1,97 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        ElementTraits.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Compile-time table of the static properties of every
+//              ParticleType (phase, density, dispersion, transition points,
+//              base color, brush density). Hot paths read a type's row with
+//              one array load instead of casting to Solid/Liquid/Gas and
+//              calling virtual getters.
+// ============================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include "Color.h"
+#include "Particle.h"
+
+// **=== Enums ===**
+
+/**
+ * @brief State of matter of a ParticleType.
+ */
+enum class MatterPhase : std::uint8_t {
+    None,   // EMPTY
+    Solid,
+    Liquid,
+    Gas
+};
+
+// **=== Structs ===**
+
+/**
+ * @brief Static properties shared by every element of one ParticleType.
+ */
+struct ElementTraits {
+    ParticleType type;           // The row's own type (checked against its index below)
+    MatterPhase phase;
+    float density;               // Relative units, water = 1.0
+    int dispersionRate;          // Cells a fluid spreads sideways per tick (0 for solids)
+    float meltingPoint;          // Solid -> liquid (Celsius, 0 if it never melts)
+    float boilingPoint;          // Liquid -> gas (Celsius, 0 if it never boils)
+    float condensationPoint;     // Gas -> liquid (Celsius, 0 if it never condenses)
+    ParticleType liquidForm;     // What it melts or condenses into (EMPTY for none)
+    ParticleType gasForm;        // What it boils into (EMPTY for none)
+    Color baseColor;             // Color before per-particle variation
+    int brushDensity;            // Percent chance the brush places a particle in each cell
+
+    /** @brief Whether the type is a liquid or a gas (can be displaced by a denser element). */
+    constexpr bool isFluid() const { return phase == MatterPhase::Liquid || phase == MatterPhase::Gas; }
+};
+
+// **=== Trait Table ===**
+
+/**
+ * @brief One row per ParticleType, in enum order.
+ * Types without an element class yet (wet sand, silt, oil, steam) are filled
+ * in so tables and the UI can already use them.
+ */
+inline constexpr std::array<ElementTraits, PARTICLE_TYPE_COUNT> ELEMENT_TRAITS = { {
+    // type                   phase                 dens  disp  melt     boil    cond    liquidForm           gasForm              baseColor                 brush
+    { ParticleType::EMPTY,   MatterPhase::None,   0.0f,  0,    0.0f,    0.0f,   0.0f,   ParticleType::EMPTY, ParticleType::EMPTY, Color(255, 255, 255),  100 },
+    { ParticleType::SAND,    MatterPhase::Solid,  1.6f,  0,    1700.0f, 0.0f,   0.0f,   ParticleType::EMPTY, ParticleType::EMPTY, Color(194, 178, 128),  85 },
+    { ParticleType::SANDWET, MatterPhase::Solid,  1.9f,  0,    1700.0f, 0.0f,   0.0f,   ParticleType::EMPTY, ParticleType::EMPTY, Color(144, 128, 78),   85 },
+    { ParticleType::DIRT,    MatterPhase::Solid,  1.7f,  0,    1500.0f, 0.0f,   0.0f,   ParticleType::EMPTY, ParticleType::EMPTY, Color(133, 94, 66),    95 },
+    { ParticleType::GRASS,   MatterPhase::Solid,  1.1f,  0,    400.0f,  0.0f,   0.0f,   ParticleType::EMPTY, ParticleType::EMPTY, Color(40, 140, 40),    90 },
+    { ParticleType::WATER,   MatterPhase::Liquid, 1.0f,  7,    0.0f,    100.0f, 0.0f,   ParticleType::EMPTY, ParticleType::STEAM, Color(60, 120, 180),   40 },
+    { ParticleType::SILT,    MatterPhase::Solid,  1.5f,  0,    1500.0f, 0.0f,   0.0f,   ParticleType::EMPTY, ParticleType::EMPTY, Color(115, 105, 90),   80 },
+    { ParticleType::OIL,     MatterPhase::Liquid, 0.8f,  4,    0.0f,    300.0f, 0.0f,   ParticleType::EMPTY, ParticleType::EMPTY, Color(90, 30, 30),     35 },
+    { ParticleType::STEAM,   MatterPhase::Gas,    0.1f,  3,    0.0f,    0.0f,   100.0f, ParticleType::WATER, ParticleType::EMPTY, Color(210, 210, 220),  50 },
+} };
+
+/**
+ * @brief Checks that every row of ELEMENT_TRAITS sits at its type's index.
+ */
+constexpr bool elementTraitsInEnumOrder() {
+    for (std::size_t i = 0; i < ELEMENT_TRAITS.size(); ++i) {
+        if (static_cast<std::size_t>(ELEMENT_TRAITS[i].type) != i) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(elementTraitsInEnumOrder(), "ELEMENT_TRAITS rows must follow the ParticleType enum order.");
+
+/**
+ * @brief Gets the static properties of a type.
+ * @param type The ParticleType.
+ * @return const ElementTraits& The type's row of ELEMENT_TRAITS.
+ */
+constexpr const ElementTraits& getElementTraits(ParticleType type) {
+    return ELEMENT_TRAITS[static_cast<std::size_t>(type)];
+}
\ No newline at end of file
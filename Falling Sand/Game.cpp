@@ -3,8 +3,8 @@
 // File:        Game.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-23
-// Last Update: 2025-04-26
-// Version:     1.7 
+// Last Update: 2026-10-16
+// Version:     2.10 
 // Description: Implementation file for the Game class.
 //              Handles the main game loop, window management, input handling,
 //              UI display and rendering logic.
@@ -12,6 +12,7 @@
 
 #include "Game.h"
 #include "Utils.h"
+#include "Trace.h"
 #include <SFML/Graphics.hpp>
 #include <vector>
 #include <string>
@@ -19,6 +20,7 @@
 #include <stdexcept>
 #include <cmath>
 #include <ctime>
+#include <iterator>
 
 // **=== Constructors & Destructors ===**
 
@@ -30,20 +32,31 @@ Game::Game() :
     m_cellWidth(5.0f),
     m_gridCols(static_cast<int>(m_windowWidth / m_cellWidth)),
     m_gridRows(static_cast<int>(m_windowHeight / m_cellWidth)),
+    m_seed(static_cast<std::uint64_t>(time(0))),
 
-    // --- Initialize World ---
-    m_world(m_gridRows, m_gridCols),
+    // --- Initialize Job System (all hardware threads) and World ---
+    m_jobs(0),
+    m_world(m_gridRows, m_gridCols, m_seed),
+    m_simulation(m_world, m_jobs, TICK_RATES[0]),
 
     // --- Initialize other members ---
     m_isRunning(true),
+    m_brushRandom(m_seed, UINT64_MAX), // Chunks use streams 0..chunkCount-1
+    m_tickRateIndex(0),
     m_lastTimeForFPS(0.f),
 
+    // --- Rendering ---
+    m_renderer(m_cellWidth),
+
+    // --- Profiling ---
+    m_showProfiler(false),
+
     // --- UI ---
     m_font(),
-    m_uiText(m_font)
+    m_uiText(m_font),
+    m_profilerText(m_font)
 {
-    // Seed random number generator
-    srand(static_cast<unsigned int>(time(0)));
+    FS_TRACE_THREAD_NAME("Main");
 
     // Load resources and setup initial state
     try {
@@ -56,7 +69,7 @@ Game::Game() :
     }
     setupInitialState();
 
-    std::cout << "Game Initialized: " << m_gridCols << "x" << m_gridRows << " grid." << std::endl;
+    std::cout << "Game Initialized: " << m_gridCols << "x" << m_gridRows << " grid, seed " << m_seed << "." << std::endl;
 }
 
 // --- Setup Helpers (Called in constructor) ----
@@ -71,13 +84,18 @@ void Game::loadResources() {
     m_uiText.setCharacterSize(20);
     m_uiText.setFillColor(sf::Color(80, 80, 80));
     m_uiText.setPosition({ 10.f, 10.f });
+
+    // Profiler overlay, to the right of the brush settings
+    m_profilerText.setFont(m_font);
+    m_profilerText.setCharacterSize(16);
+    m_profilerText.setFillColor(sf::Color(80, 80, 80));
+    m_profilerText.setPosition({ 320.f, 10.f });
 }
 
 void Game::setupInitialState() {
     // Set initial brush settings
     m_brushSize = 5;
     m_brushType = ParticleType::SAND;
-    m_gridVertices.setPrimitiveType(sf::PrimitiveType::Triangles);
 
     // Set the window style
     auto windowStyle = sf::Style::Titlebar | sf::Style::Close | sf::Style::Resize;
@@ -105,6 +123,8 @@ void Game::setupInitialState() {
 // **=== Main Public Methods ===**
 
 void Game::run() {
+    // The world ticks on its own thread from here on; this loop only handles input and drawing
+    m_simulation.start();
     while (m_window.isOpen() && m_isRunning)
     {
         // --- Timing & FPS calculation --
@@ -117,19 +137,27 @@ void Game::run() {
         m_window.setTitle("Falling Sand | FPS: " + std::to_string(static_cast<int>(fps)));
 
         // **=== Game Loop Phases ===**
-        
-        // 1. Handle discrete window/keyboard events
-        processEvents();
+        ScopedTimer frameTimer(&m_profiler, ProfilePhase::Frame);
+        FS_TRACE_SCOPE("Frame");
+
+        {
+            ScopedTimer eventsTimer(&m_profiler, ProfilePhase::Events);
+            FS_TRACE_SCOPE("Events");
+
+            // 1. Handle discrete window/keyboard events
+            processEvents();
 
-        // 2. Handle continuous real-time input (like mouse being held down)
-        handleRealtimeInput();
+            // 2. Handle continuous real-time input (like mouse being held down)
+            handleRealtimeInput();
+        }
 
-        // 3. Update the game state (run simulation step, update UI text)
+        // 3. Update the game state (pick up the simulation's newest snapshot, update UI text)
         update();
 
         // 4. Render the current state to the screen
         render();
     }
+    m_simulation.stop();
 }
 
 // **=== Private Methods ===**
@@ -179,6 +207,35 @@ void Game::processEvents() {
             if (keyPressed->scancode == sf::Keyboard::Scan::Num5) { m_brushType = ParticleType::OIL; }
             if (keyPressed->scancode == sf::Keyboard::Scan::Num6) { m_brushType = ParticleType::SANDWET; }
 
+            // **=== Simulation Settings ===**
+
+            // -- Toggle parallel chunk update (job system <-> single thread) --
+            if (keyPressed->scancode == sf::Keyboard::Scan::P) {
+                m_simulation.post([this](World& world) { world.setJobSystem(world.getJobSystem() ? nullptr : &m_jobs); });
+            }
+
+            // -- Toggle per-type batched updates --
+            if (keyPressed->scancode == sf::Keyboard::Scan::B) {
+                m_simulation.post([](World& world) { world.setBatchByType(!world.isBatchingByType()); });
+            }
+
+            // -- Cycle the simulation tick rate --
+            if (keyPressed->scancode == sf::Keyboard::Scan::F5) {
+                m_tickRateIndex = (m_tickRateIndex + 1) % static_cast<int>(std::size(TICK_RATES));
+                m_simulation.setTickRate(TICK_RATES[m_tickRateIndex]);
+            }
+
+            // -- Toggle the profiler overlay --
+            if (keyPressed->scancode == sf::Keyboard::Scan::F3) {
+                m_showProfiler = !m_showProfiler;
+                m_simulation.setReportsEnabled(m_showProfiler);
+            }
+
+            // -- Save the recent timeline as a Chrome trace --
+            if (keyPressed->scancode == sf::Keyboard::Scan::F4) {
+                saveTrace();
+            }
+
         }
     }
 }
@@ -195,6 +252,12 @@ void Game::handleRealtimeInput() {
 		// Place particles based on the current brush settings
 		placeParticles(mouseCol, mouseRow);
     }
+
+    // Hand the frame's placements to the simulation in one go
+    if (!m_brushPlacements.empty()) {
+        m_simulation.requestPlacements(m_brushPlacements);
+        m_brushPlacements.clear();
+    }
 }
 
 void Game::placeParticles(int mouseGridX, int mouseGridY) {
@@ -206,14 +269,14 @@ void Game::placeParticles(int mouseGridX, int mouseGridY) {
         for (int j = -extent; j <= extent; ++j) { // Iterate cols within extent
 
             // -- Brush Density --
-			if (rand() % 100 < Utils::getDensityForType(m_brushType)) { // Fires with a chance of the brush type density
+			if (m_brushRandom.chance(Utils::getDensityForType(m_brushType))) { // Fires with a chance of the brush type density
 				// Rows/cols brush is in
 				int col = mouseGridX + j;
 				int row = mouseGridY + i;
 
 
 				if (row >= 0 && row < m_gridRows && col >= 0 && col < m_gridCols) { // If within bounds
-					m_world.requestPlacement(row, col, m_brushType); // Request placement in the world
+					m_brushPlacements.push_back({ row, col, m_brushType }); // Request placement in the world
 				}
 			}
 			// TODO : Could extend this logic here for different shaped brushes
@@ -222,89 +285,77 @@ void Game::placeParticles(int mouseGridX, int mouseGridY) {
 }
 
 void Game::update() {
-    // Advance particle sim by one step
-	m_world.update();
+    // Take the simulation's newest snapshot, if it published one since the last frame, and upload its changes
+    if (m_simulation.acquireSnapshot()) {
+        ScopedTimer timer(&m_profiler, ProfilePhase::PrepareFrame);
+        m_renderer.prepareFrame(m_simulation.getSnapshot());
+    }
 
     // Update the UI
 	updateUIText();
 }
 
 void Game::render() {
-    // Prepare vertex array
-    prepareVertices();
+    // Render phase includes the frame limiter's wait inside display()
+    ScopedTimer timer(&m_profiler, ProfilePhase::Render);
+    FS_TRACE_SCOPE("Render");
     // Clear the window
 	m_window.clear(sf::Color::White); // Background is white
 	// Draw the grid
-	m_window.draw(m_gridVertices);
+	m_renderer.draw(m_window);
 	// Draw the UI text
 	m_window.draw(m_uiText);
+    if (m_showProfiler) {
+        m_window.draw(m_profilerText);
+    }
 	// Display the contents of the window
+    FS_TRACE_SCOPE("Display");
     m_window.display();
 }
 
+void Game::saveTrace() {
+    if (!Trace::ENABLED) {
+        std::cout << "Tracing is compiled out (FALLING_SAND_ENABLE_TRACE=0)." << std::endl;
+        return;
+    }
+    // Pause the simulation thread (and with it the workers) so the buffers can be read safely
+    m_simulation.stop();
+    try {
+        const std::size_t events = Trace::writeChromeTrace(TRACE_FILE_NAME);
+        std::cout << "Saved " << events << " trace events to " << TRACE_FILE_NAME << "." << std::endl;
+    }
+    catch (const std::runtime_error& e) {
+        std::cerr << "[ERROR] " << e.what() << std::endl;
+    }
+    m_simulation.start();
+}
+
 void Game::updateUIText() {
     // Get string for ui from brush type
 	std::string particleTypeName = Utils::getNameForType(m_brushType);
 
-	// Text to display
+	// Text to display, from the snapshot being drawn
+    const RenderSnapshot& snapshot = m_simulation.getSnapshot();
+    // Element pool occupancy (live particles / pooled slots)
+    const ElementPoolStats& poolStats = snapshot.pools;
+    const double tickRate = m_simulation.getTickRate();
+
     std::string displayText = "BRUSH SETTINGS:\n"
 		"Type: " + particleTypeName + "\n" +
-        "Size: " + std::to_string(m_brushSize);
+        "Size: " + std::to_string(m_brushSize) + "\n" +
+        "Particles: " + std::to_string(poolStats.inUse) + " / " + std::to_string(poolStats.capacity) + "\n" +
+        "Chunks: " + std::to_string(snapshot.activeChunks) + " / " + std::to_string(snapshot.chunkCount) + "\n" +
+        "Awake: " + std::to_string(snapshot.awakeCells) + "\n" +
+        "Redrawn: " + std::to_string(m_renderer.getLastRepaintedCells()) + " cells\n" +
+        "Threads: " + std::to_string(snapshot.threadCount) + " (P to toggle)\n" +
+        "Order: " + (snapshot.batchingByType ? "by type" : "rows") + " (B to toggle)\n" +
+        "Ticks/s: " + std::to_string(static_cast<int>(snapshot.ticksPerSecond + 0.5)) + " / " +
+            (tickRate > 0.0 ? std::to_string(static_cast<int>(tickRate)) : std::string("max")) + " (F5 to change)\n" +
+        "Profiler: F3  Trace: F4";
 
 	// Set the UI text
     m_uiText.setString(displayText);
-}
-
-void Game::prepareVertices() {
-    m_gridVertices.clear();
-    const auto& currentGrid = m_world.getGridState();
-    const sf::Color baseWaterColor(60, 120, 180); // Define base water color once
-    const sf::Color deepWaterColor(20, 40, 80);  // Define the darkest color for the bottom
-
-    for (int r = 0; r < m_gridRows; ++r) {
-        for (int c = 0; c < m_gridCols; ++c) {
-            const std::unique_ptr<Element>& elementPtr = currentGrid[r][c];
-            if (elementPtr) {
-                Element* element = elementPtr.get();
-                sf::Color particleColor;
-
-                // --- Check if it's water ---
-                if (element->getType() == ParticleType::WATER) {
-                    // --- Apply Vertical Gradient ---
-                    // Calculate depth factor (0.0 at top, 1.0 at bottom)
-                    float depthFactor = static_cast<float>(r) / static_cast<float>(m_gridRows - 1);
-                    depthFactor = std::min(1.0f, depthFactor); // Clamp factor just in case
-
-                    // Interpolate between base and deep colors
-                    uint8_t red = static_cast<uint8_t>(baseWaterColor.r + (deepWaterColor.r - baseWaterColor.r) * depthFactor);
-                    uint8_t green = static_cast<uint8_t>(baseWaterColor.g + (deepWaterColor.g - baseWaterColor.g) * depthFactor);
-                    uint8_t blue = static_cast<uint8_t>(baseWaterColor.b + (deepWaterColor.b - baseWaterColor.b) * depthFactor);
-                    particleColor = sf::Color(red, green, blue);
-                }
-                else {
-                    // For other elements, use their stored render color
-                    particleColor = element->getRenderColor(); // Use existing color for non-water
-                }
-
-
-                // --- Create vertices ---
-                float left = static_cast<float>(c) * m_cellWidth;
-                float top = static_cast<float>(r) * m_cellWidth;
-                float right = left + m_cellWidth;
-                float bottom = top + m_cellWidth;
-
-                sf::Vertex topLeft(sf::Vector2f(left, top), particleColor);
-                sf::Vertex topRight(sf::Vector2f(right, top), particleColor);
-                sf::Vertex bottomLeft(sf::Vector2f(left, bottom), particleColor);
-                sf::Vertex bottomRight(sf::Vector2f(right, bottom), particleColor);
-
-                m_gridVertices.append(topLeft);
-                m_gridVertices.append(topRight);
-                m_gridVertices.append(bottomRight);
-                m_gridVertices.append(topLeft);
-                m_gridVertices.append(bottomRight);
-                m_gridVertices.append(bottomLeft);
-            }
-        }
+    if (m_showProfiler) {
+        m_profilerText.setString(m_profiler.formatReport() + "\nSIMULATION THREAD:\n" + snapshot.profilerReport + "\nLAST TICK EVENTS:\n" + snapshot.statsReport);
     }
 }
\ No newline at end of file
@@ -3,8 +3,8 @@
 // File:        Game.h
 // Author:      Foster Rae
 // Date Created:2025-04-23
-// Last Update: 2025-04-23
-// Version:     1.7
+// Last Update: 2026-10-16
+// Version:     1.13
 // Description: Header file for the Game class. 
 //              Handles the main game loop, window management, input handling,
 //              UI display and rendering.
@@ -17,6 +17,12 @@
 #include <vector>
 #include "World.h"
 #include "Particle.h"
+#include "JobSystem.h"
+#include "Random.h"
+#include "GridRenderer.h"
+#include "Profiler.h"
+#include "SimulationThread.h"
+#include <cstdint>
 
 class Game
 {
@@ -36,11 +42,18 @@ public:
     void run();
 
 private:
+    // **=== Constants ===**
+    /** @brief File F4 writes the Chrome trace to, in the working directory. */
+    static constexpr const char* TRACE_FILE_NAME = "falling_sand_trace.json";
+    /** @brief Simulation tick rates F5 cycles through (0 = as fast as possible). */
+    static constexpr double TICK_RATES[] = { 60.0, 120.0, 240.0, 30.0, 0.0 };
+
 	// **=== Private Members ===**
     // -- Config / Base Variables --
     float m_cellWidth;
     unsigned int m_windowWidth;
     unsigned int m_windowHeight;
+    std::uint64_t m_seed; // Seed of the world and brush random streams (printed at startup)
 
     // -- Calculated Variables --
     int m_gridCols;
@@ -48,24 +61,34 @@ private:
 
     // -- Core Components (Depend on calculated values) --
     sf::RenderWindow m_window;
-    World m_world;
+    JobSystem m_jobs; // Declared before m_world so it outlives the world's use of it
+    World m_world;         // Belongs to m_simulation's thread while it runs
+    SimulationThread m_simulation; // Declared after m_world and m_jobs so it stops before they go
 
     // -- Game State & Settings --
     bool m_isRunning;
     int m_brushSize;
     ParticleType m_brushType;
 	int m_brushDensity;
+    Random m_brushRandom; // Brush density rolls; a separate stream from the world's chunks
+    std::vector<PlacementRequest> m_brushPlacements; // This frame's brush placements, sent to the simulation together
+    int m_tickRateIndex;  // Current entry of TICK_RATES
 
     // -- Timing & FPS --
     sf::Clock m_clock;
     float m_lastTimeForFPS;
 
     // -- Rendering --
-    sf::VertexArray m_gridVertices;
+    GridRenderer m_renderer;
+
+    // -- Profiling --
+    Profiler m_profiler;  // Phase timings of each frame (the simulation thread times the world's)
+    bool m_showProfiler;  // Whether the profiler overlay is drawn (F3 to toggle)
 
     // -- UI --
     sf::Font m_font;
     sf::Text m_uiText;
+    sf::Text m_profilerText; // Profiler overlay, drawn next to m_uiText
 
 	// **=== Private Methods ===**
     
@@ -80,14 +103,15 @@ private:
     void handleRealtimeInput();
     
     /**
-	 * @brief Places particles in the world based on current brush settings.
+	 * @brief Sends particle placements to the simulation based on current brush settings.
 	 * @param mouseGridX The grid column index where the mouse is located.
 	 * @param mouseGridY The grid row index where the mouse is located.
      */
     void placeParticles(int mouseGridX, int mouseGridY);
 
     /**
-	 * @brief Updates the overall game state for the current frame. Calls the world update method and UI updates.
+	 * @brief Updates the overall game state for the current frame: picks up the simulation's
+	 * newest snapshot (uploading it to the grid texture) and updates the UI.
      */
     void update();
 
@@ -97,14 +121,14 @@ private:
     void render();
 
     /**
-	 * @brief Updates the UI with the current info.
+	 * @brief Writes the recent trace events to TRACE_FILE_NAME (F4).
      */
-    void updateUIText();
+    void saveTrace();
 
     /**
-	 * @brief Iterates through the grid and prepares the vertex array for rendering.
+	 * @brief Updates the UI with the current info.
      */
-    void prepareVertices();
+    void updateUIText();
 
     /**
 	 * @brief Loads the resources needed for the game (fonts, textures, etc.), and sets up the UI.
@@ -1 +1,84 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Gas.cpp
+// Author:      Foster Rae
+// Date Created:2025-04-25
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Implementation file for the Gas abstract class.
+//              Contains common logic shared by all gas elements,
+//              including rising/expansion and condensation behaviours.
+// ============================================================================
+
 #include "Gas.h"
+#include "World.h"
+#include "Particle.h"
+#include <utility>
+#include <memory>
+
+// **=== Protected Helper Methods ===**
+
+bool Gas::attemptExpansion(World& world, int r, int c) {
+
+    // --- Priority 1: Try Move/Swap Directly Above ---
+    if (world.tryMoveOrSwap(r, c, r - 1, c)) {
+        return true; // Rose up
+    }
+
+    // --- Priority 2: Try Move/Swap Diagonals Up ---
+    Random& rng = world.getRandom(r, c);
+    int diag_dir = rng.nextDirection(); // Randomize diagonal check order
+    if (world.tryMoveOrSwap(r, c, r - 1, c + diag_dir)) {
+        return true;
+    }
+    if (world.tryMoveOrSwap(r, c, r - 1, c - diag_dir)) {
+        return true;
+    }
+
+    // --- Priority 3: Spread Sideways ---
+    // Drift as far as the dispersion rate allows through empty cells, trying a random side first
+    int dispersion = this->getDispersionRate();
+    int horiz_dir = rng.nextDirection(); // Randomize side check order
+
+    for (int i = 0; i < 2; ++i) { // Check both L/R directions
+        int farthest_c = c; // c means no free cell found on this side
+        for (int step = 1; step <= dispersion; ++step) {
+            int check_c = c + (horiz_dir * step);
+            if (!world.isWithinBounds(r, check_c) || world.getElement(r, check_c) || world.isClaimedThisTick(r, check_c)) {
+                break; // Blocked, stop checking this direction
+            }
+            farthest_c = check_c;
+        }
+        if (farthest_c != c && world.tryMoveOrSwap(r, c, r, farthest_c)) {
+            return true; // Spread horizontally
+        }
+        horiz_dir *= -1; // Flip direction to check other side
+    }
+
+    // --- No Movement ---
+    return false;
+}
+
+bool Gas::tryCondense(World& world, int r, int c) {
+    // 1. Check temperature
+    if (this->getTemperature() > this->getCondensationPoint()) {
+        return false; // Still too hot
+    }
+
+    // 2. Probability Check (condense gradually rather than all at once)
+    const int CONDENSATION_CHANCE = 5; // Percent
+    Random& rng = world.getRandom(r, c);
+    if (!rng.chance(CONDENSATION_CHANCE)) {
+        return false; // Didn't condense this tick
+    }
+
+    // 3. Conditions met - Condense!
+    ParticleType liquidType = this->getLiquidForm();
+    if (liquidType == ParticleType::EMPTY) { // Check if a valid liquid form is defined
+        return false;
+    }
+
+    // Turn this gas into the liquid in place. On success this object is gone,
+    // so the caller must not touch it again.
+    return world.morphElement(r, c, liquidType);
+}
\ No newline at end of file
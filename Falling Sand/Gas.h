@@ -3,8 +3,8 @@
 // File:        Gas.h
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.4
 // Description: Header file for the Gas abstract class.
 //              Inherits from Element and serves as a base for all gaseous
 //              particle types. Defines common gas properties (density,
@@ -27,7 +27,13 @@ class World;
  */
 class Gas : public Element {
 public:
-    // **=== Destructor ===**
+    // **=== Constructors & Destructor ===**
+
+    /**
+     * @brief Constructs a gas element.
+     * @param type The concrete element's ParticleType.
+     */
+    explicit Gas(ParticleType type) : Element(type) {}
 
     /**
      * @brief Virtual destructor. Ensures proper cleanup for derived classes.
@@ -50,15 +56,9 @@ public:
 
     /**
      * @brief Gets the display color of this gas element.
-     * @return sf::Color The color for rendering.
-     */
-    virtual sf::Color getColor() const = 0;
-
-    /**
-     * @brief Gets the specific type identifier for this gas element.
-     * @return ParticleType The enum value (e.g., ParticleType::STEAM).
+     * @return Color The color for rendering.
      */
-    virtual ParticleType getType() const = 0;
+    virtual Color getColor() const = 0;
 
     /**
      * @brief Gets the density of this gas element. Crucial for buoyancy
@@ -109,15 +109,15 @@ protected:
      * @param c Current column.
      * @return true if the gas successfully moved or swapped, false otherwise.
      */
-    virtual bool attemptExpansion(World& world, int r, int c); // Declaration only
+    virtual bool attemptExpansion(World& world, int r, int c);
 
     /**
      * @brief Attempts to condense the gas into its liquid form based on temperature.
      * @param world Reference to the world grid.
      * @param r Current row.
      * @param c Current column.
-     * @return true if condensation occurred and element was replaced, false otherwise.
+     * @return true if the gas turned into its liquid form in place (this object is then gone), false otherwise.
      */
-    virtual bool tryCondense(World& world, int r, int c); // Declaration only
+    virtual bool tryCondense(World& world, int r, int c);
 
 };
\ No newline at end of file
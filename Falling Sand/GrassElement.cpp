@@ -3,41 +3,35 @@
 // File:        GrassElement.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-26
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.7
 // Description: Implementation file for the GrassElement class.
 // ============================================================================
 
 #include "GrassElement.h"
 #include "World.h"
 #include "Particle.h"
-#include <SFML/Graphics.hpp>
-#include <cstdlib>
 #include <memory>
 #include <iostream>
 #include "DirtElement.h"
 
 // **=== Constructor ===**
-GrassElement::GrassElement() : m_timeSinceCovered(0) {
-    initializeColorVariation(getColor());
-}
+GrassElement::GrassElement() : StaticSolid(ParticleType::GRASS), m_timeSinceCovered(0) {}
 
 // **=== Overridden Public Methods ===**
 
 void GrassElement::update(World& world, int r, int c) {
     age++;
-    bool becameDirt = false;
+    Random& rng = world.getRandom(r, c);
 
     // --- Grass Death Logic ---
     Element* elementAbove = world.getElement(r - 1, c);
 
 	// If dirt above die instantly
     if (elementAbove && elementAbove->getType() == ParticleType::DIRT) {
-		// Grass dies and turns into dirt
-		std::unique_ptr<Element> newDirt = world.createElementByType(ParticleType::DIRT);
-		if (newDirt) {
-			world.setNextElement(r, c, std::move(newDirt));
-			becameDirt = true;
+		// Grass dies and turns into dirt in place. This object is gone afterwards, so stop here.
+		if (world.morphElement(r, c, ParticleType::DIRT)) {
+			return;
 		}
     }
 
@@ -48,12 +42,10 @@ void GrassElement::update(World& world, int r, int c) {
         // Check if covered for long enough
         if (m_timeSinceCovered > GRASS_DEATH_TIME_THRESHOLD) {
             // Now check random chance to die
-            if ((rand() % 100) < GRASS_DEATH_CHANCE_PERCENT) {
-                // Grass dies and turns into dirt
-                std::unique_ptr<Element> newDirt = world.createElementByType(ParticleType::DIRT);
-                if (newDirt) {
-                    world.setNextElement(r, c, std::move(newDirt));
-                    becameDirt = true;
+            if (rng.chance(GRASS_DEATH_CHANCE_PERCENT)) {
+                // Grass dies and turns into dirt in place
+                if (world.morphElement(r, c, ParticleType::DIRT)) {
+                    return;
                 }
             }
         }
@@ -66,23 +58,16 @@ void GrassElement::update(World& world, int r, int c) {
     }
 
 
-    // --- Update Mark ---
-    if (!becameDirt) {
-        this->wakeUp();
-        this->markAsUpdated();
-    }
-}
-
-sf::Color GrassElement::getColor() const {
-    return sf::Color(40, 140, 40);
+    // --- Stay Awake ---
+    this->wakeUp();
 }
 
-ParticleType GrassElement::getType() const {
-    return ParticleType::GRASS;
+Color GrassElement::getColor() const {
+    return getTraits().baseColor;
 }
 
 float GrassElement::getDensity() const {
-    return 1.1f;
+    return getTraits().density;
 }
 
 // **=== Concrete Property Implementations ===**
@@ -97,17 +82,17 @@ float GrassElement::getThermalConductivity() const {
 
 float GrassElement::getMeltingPoint() const {
     // Grass burns/decomposes. Use a relatively low temp compared to rock/sand.
-    return 400.0f; // Example decomposition/ignition temperature?
+    return getTraits().meltingPoint; // Example decomposition/ignition temperature?
 }
 
 ParticleType GrassElement::getLiquidForm() const {
     // Doesn't melt into a liquid. Maybe turns to Ash?
     // TODO: Add ASH type later?
-    return ParticleType::EMPTY; // Placeholder
+    return getTraits().liquidForm; // Placeholder (EMPTY)
 }
 
 ParticleType GrassElement::getGasForm() const {
     // Burns into maybe smoke/carbon? Needs reaction system.
     // TODO: Add SMOKE type later?
-    return ParticleType::EMPTY; // Placeholder
+    return getTraits().gasForm; // Placeholder (EMPTY)
 }
\ No newline at end of file
@@ -3,8 +3,8 @@
 // File:        GrassElement.h
 // Author:      Foster Rae
 // Date Created:2025-04-26
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.7
 // Description: Header file for the GrassElement class. Represents grass.
 //              Inherits from StaticSolid. Can turn back into Dirt if covered.
 // ============================================================================
@@ -25,9 +25,24 @@ class World;
  */
 class GrassElement : public StaticSolid {
 public:
+    // **=== Constants ===**
+    // (Public so the CompactWorld's grass follows the same rules)
+    /**
+     * @brief Chance (out of 100) per tick for grass to die and turn to dirt if covered.
+     */
+    static constexpr int GRASS_DEATH_CHANCE_PERCENT = 2;
+
+    /**
+     * @brief Minimum time (in ticks) grass must be covered by non-grass/non-air before potentially dying.
+     */
+    static constexpr int GRASS_DEATH_TIME_THRESHOLD = 150;
+
     // **=== Constructors / Destructor ===**
 
-    /** @brief Default constructor. */
+    /**
+     * @brief Constructs a grass element.
+     * (Its color variant is seeded by World::createElementByType(), see Element::seedColorVariant().)
+     */
     GrassElement();
     /** @brief Default virtual destructor. */
     virtual ~GrassElement() = default;
@@ -44,15 +59,9 @@ public:
 
     /**
      * @brief Gets the display color for Grass.
-     * @return sf::Color The color of grass.
+     * @return Color The color of grass.
      */
-    sf::Color getColor() const override;
-
-    /**
-     * @brief Gets the type identifier for Grass.
-     * @return ParticleType The ParticleType::GRASS enum value.
-     */
-    ParticleType getType() const override;
+    Color getColor() const override;
 
     /**
      * @brief Gets the density of Grass.
@@ -95,16 +104,6 @@ public:
 private:
     // **=== Private Members ===**
 
-    /**
-     * @brief Chance (out of 100) per tick for grass to die and turn to dirt if covered.
-     */
-    static constexpr int GRASS_DEATH_CHANCE_PERCENT = 2;
-
-    /**
-     * @brief Minimum time (in ticks) grass must be covered by non-grass/non-air before potentially dying.
-     */
-    static constexpr int GRASS_DEATH_TIME_THRESHOLD = 150;
-
     /**
      * @brief Tracks how long (in ticks) this grass particle has been covered
      * by a non-grass/non-air element continuously. Resets if uncovered or covered by grass.
@@ -0,0 +1,118 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        GridRenderer.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.5
+// Description: Implementation file for the GridRenderer class.
+// ============================================================================
+
+#include "GridRenderer.h"
+#include "World.h"
+#include "JobSystem.h"
+#include "SimulationThread.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+
+// **=== Constructors ===**
+
+GridRenderer::GridRenderer(float cellSize) : m_cellSize(cellSize), m_quad(sf::PrimitiveType::TriangleStrip, 4) {}
+
+// **=== Public Methods ===**
+
+void GridRenderer::prepareFrame(World& world, JobSystem& jobs) {
+    FS_TRACE_SCOPE("Prepare Frame");
+    world.takeChangedAreas(m_changedAreas);
+    const bool fullUpload = needsFullUpload(world.getRows(), world.getCols(), m_changedAreas, false);
+    if (fullUpload) {
+        m_plane.fill(world, jobs);
+    }
+    else {
+        // One area per chunk at most, never overlapping, so in parallel
+        jobs.parallelFor(0, static_cast<int>(m_changedAreas.size()), 4, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                m_plane.fillArea(world, m_changedAreas[i]);
+            }
+        });
+    }
+    upload(m_plane, m_changedAreas, fullUpload);
+}
+
+void GridRenderer::prepareFrame(const RenderSnapshot& snapshot) {
+    FS_TRACE_SCOPE("Prepare Frame");
+    const ColorPlane& plane = snapshot.plane;
+    upload(plane, snapshot.changedAreas, needsFullUpload(plane.getRows(), plane.getCols(), snapshot.changedAreas, snapshot.fullRepaint));
+}
+
+void GridRenderer::draw(sf::RenderTarget& target) const {
+    sf::RenderStates states;
+    states.texture = &m_texture;
+    target.draw(m_quad, states);
+}
+
+// **=== Private Methods ===**
+
+std::size_t GridRenderer::countCells(const std::vector<DirtyRect>& areas) {
+    std::size_t cells = 0;
+    for (const DirtyRect& area : areas) {
+        cells += static_cast<std::size_t>(area.maxR - area.minR + 1) * (area.maxC - area.minC + 1);
+    }
+    return cells;
+}
+
+bool GridRenderer::needsFullUpload(int rows, int cols, const std::vector<DirtyRect>& changedAreas, bool fullRepaint) const {
+    // First frame, new grid size, or most of the grid changed
+    return m_fullRepaint || fullRepaint
+        || m_texture.getSize() != sf::Vector2u(static_cast<unsigned>(cols), static_cast<unsigned>(rows))
+        || countCells(changedAreas) > static_cast<std::size_t>(rows) * cols / 2;
+}
+
+void GridRenderer::upload(const ColorPlane& plane, const std::vector<DirtyRect>& changedAreas, bool fullUpload) {
+    FS_TRACE_SCOPE("Upload Texture");
+    if (fullUpload) {
+        if (m_texture.getSize() != sf::Vector2u(static_cast<unsigned>(plane.getCols()), static_cast<unsigned>(plane.getRows()))) {
+            resizeTexture(plane.getRows(), plane.getCols());
+        }
+        m_texture.update(plane.getBytes());
+        m_fullRepaint = false;
+        m_lastRepaintedCells = static_cast<std::size_t>(plane.getRows()) * plane.getCols();
+        return;
+    }
+    for (const DirtyRect& area : changedAreas) {
+        uploadArea(plane, area);
+    }
+    m_lastRepaintedCells = countCells(changedAreas);
+}
+
+void GridRenderer::resizeTexture(int rows, int cols) {
+    if (!m_texture.resize(sf::Vector2u(static_cast<unsigned>(cols), static_cast<unsigned>(rows)))) {
+        throw std::runtime_error("Could not create the " + std::to_string(cols) + "x" + std::to_string(rows) + " grid texture.");
+    }
+    m_texture.setSmooth(false); // Hard cell edges when scaled up
+
+    const float width = static_cast<float>(cols) * m_cellSize;
+    const float height = static_cast<float>(rows) * m_cellSize;
+    const float texWidth = static_cast<float>(cols);
+    const float texHeight = static_cast<float>(rows);
+    m_quad[0] = sf::Vertex{ sf::Vector2f(0.0f, 0.0f), sf::Color::White, sf::Vector2f(0.0f, 0.0f) };
+    m_quad[1] = sf::Vertex{ sf::Vector2f(width, 0.0f), sf::Color::White, sf::Vector2f(texWidth, 0.0f) };
+    m_quad[2] = sf::Vertex{ sf::Vector2f(0.0f, height), sf::Color::White, sf::Vector2f(0.0f, texHeight) };
+    m_quad[3] = sf::Vertex{ sf::Vector2f(width, height), sf::Color::White, sf::Vector2f(texWidth, texHeight) };
+}
+
+void GridRenderer::uploadArea(const ColorPlane& plane, const DirtyRect& area) {
+    const int width = area.maxC - area.minC + 1;
+    const int height = area.maxR - area.minR + 1;
+    m_uploadBuffer.resize(static_cast<std::size_t>(width) * height);
+    for (int r = area.minR; r <= area.maxR; ++r) {
+        const Color* row = &plane.getPixel(r, area.minC);
+        std::copy(row, row + width, m_uploadBuffer.begin() + static_cast<std::ptrdiff_t>(r - area.minR) * width);
+    }
+    m_texture.update(&m_uploadBuffer.front().r,
+        sf::Vector2u(static_cast<unsigned>(width), static_cast<unsigned>(height)),
+        sf::Vector2u(static_cast<unsigned>(area.minC), static_cast<unsigned>(area.minR)));
+}
\ No newline at end of file
@@ -0,0 +1,141 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        GridRenderer.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.3
+// Description: Header file for the GridRenderer class.
+//              Draws the World's grid as one texture with a pixel per cell,
+//              scaled up to the cell size on a single quad.
+//              Split out of Game so it can be benchmarked without a window.
+// ============================================================================
+
+#pragma once
+
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <vector>
+#include "ColorPlane.h"
+#include "WorldChunk.h"
+
+class World;
+class JobSystem;
+struct RenderSnapshot;
+
+/**
+ * @brief Paints the World's grid into a ColorPlane, uploads it to a texture
+ * and draws that texture stretched over the grid's on-screen area.
+ *
+ * After the first frame only the areas the World reports as changed (see
+ * World::takeChangedAreas()) are repainted and uploaded, so a settled scene
+ * costs little more than its moving cells. The cost never depends on the cell
+ * size or on how many cells are occupied.
+ */
+class GridRenderer {
+public:
+    // **=== Constructors ===**
+
+    /**
+     * @brief Constructs a renderer for cells of the given on-screen size.
+     * @param cellSize Width and height of one cell in pixels.
+     */
+    explicit GridRenderer(float cellSize);
+
+    GridRenderer(const GridRenderer&) = delete;
+    GridRenderer& operator=(const GridRenderer&) = delete;
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Brings the texture up to date with the world's grid. Takes the world's changed
+     * areas, repaints them in the color plane (in parallel on the job system) and uploads
+     * each one; the first frame, or one where more than half the grid changed, repaints
+     * and uploads everything.
+     * @param world The world to draw. Its changed areas are consumed.
+     * @param jobs Job system to spread the work over.
+     * @throws std::runtime_error if the texture cannot be created.
+     */
+    void prepareFrame(World& world, JobSystem& jobs);
+
+    /**
+     * @brief Brings the texture up to date with a snapshot published by a SimulationThread,
+     * uploading its changed areas (or all of it, under the same conditions as above).
+     * @param snapshot The snapshot; its plane is uploaded directly, the renderer's own is unused.
+     * @throws std::runtime_error if the texture cannot be created.
+     */
+    void prepareFrame(const RenderSnapshot& snapshot);
+
+    /**
+     * @brief Makes the next prepareFrame() repaint and upload the whole grid.
+     */
+    void invalidate() { m_fullRepaint = true; }
+
+    /**
+     * @brief Draws the texture uploaded by the last prepareFrame().
+     * @param target The window (or other render target) to draw into.
+     */
+    void draw(sf::RenderTarget& target) const;
+
+    /**
+     * @brief Gets the pixels painted by the last prepareFrame() from a World.
+     * @return const ColorPlane& The color plane.
+     */
+    const ColorPlane& getColorPlane() const { return m_plane; }
+
+    /**
+     * @brief Gets the number of cells repainted and uploaded by the last prepareFrame().
+     * @return std::size_t The cell count.
+     */
+    std::size_t getLastRepaintedCells() const { return m_lastRepaintedCells; }
+
+private:
+    // **=== Private Members ===**
+    float m_cellSize;
+    ColorPlane m_plane;
+    sf::Texture m_texture;
+    /** @brief The grid's quad, 0 to cols x rows cells on screen, the whole texture mapped onto it. */
+    sf::VertexArray m_quad;
+    bool m_fullRepaint = true;
+    std::size_t m_lastRepaintedCells = 0;
+    /** @brief This frame's changed areas, reused between frames. */
+    std::vector<DirtyRect> m_changedAreas;
+    /** @brief One changed area's pixels, packed for sf::Texture::update(). */
+    std::vector<Color> m_uploadBuffer;
+
+    // **=== Private Methods ===**
+
+    /**
+     * @brief Sizes the texture and the quad for a new grid size.
+     * @param rows Number of grid rows.
+     * @param cols Number of grid columns.
+     * @throws std::runtime_error if the texture cannot be created.
+     */
+    void resizeTexture(int rows, int cols);
+
+    /**
+     * @brief Adds up the cells of some areas.
+     */
+    static std::size_t countCells(const std::vector<DirtyRect>& areas);
+
+    /**
+     * @brief Decides whether a frame uploads the whole plane: on the first frame, after
+     * invalidate(), for a new grid size, when asked to, or when most of the grid changed.
+     */
+    bool needsFullUpload(int rows, int cols, const std::vector<DirtyRect>& changedAreas, bool fullRepaint) const;
+
+    /**
+     * @brief Uploads a plane's changed areas, or all of it, to the texture.
+     * @param plane The pixels.
+     * @param changedAreas The areas to upload when not uploading everything.
+     * @param fullUpload True to upload the whole plane (resizing the texture if needed).
+     */
+    void upload(const ColorPlane& plane, const std::vector<DirtyRect>& changedAreas, bool fullUpload);
+
+    /**
+     * @brief Uploads one area of a plane to the same place in the texture.
+     * @param plane The pixels.
+     * @param area The inclusive area.
+     */
+    void uploadArea(const ColorPlane& plane, const DirtyRect& area);
+};
\ No newline at end of file
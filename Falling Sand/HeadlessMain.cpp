@@ -0,0 +1,205 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        HeadlessMain.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.5
+// Description: Main entry point for the headless simulation runner.
+//              Runs the World without a window (no SFML) for a fixed number
+//              of ticks as fast as possible and reports the throughput, so
+//              the simulation can be measured on machines with no display.
+// ============================================================================
+
+#include "World.h"
+#include "CompactWorld.h"
+#include "JobSystem.h"
+#include "Scenarios.h"
+#include "Profiler.h"
+#include "Trace.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @brief Settings of one headless run, filled from the command line.
+ */
+struct HeadlessOptions {
+    int rows = 180;                           // Same grid as the Game's 1600x900 window at 5px cells
+    int cols = 320;
+    int ticks = 1000;
+    int threads = 0;                          // 0 = all hardware threads, 1 = single-threaded sweep
+    std::uint64_t seed = World::DEFAULT_SEED;
+    std::string scenario = "mixed";
+    std::string tracePath;                    // Chrome trace output, empty = none
+    bool batchByType = false;                 // World::setBatchByType()
+    std::string engine = "objects";           // "objects" (World) or "compact" (CompactWorld)
+    bool showHelp = false;
+};
+
+/**
+ * @brief Prints the command line usage.
+ */
+static void printUsage(std::ostream& out) {
+    out << "Usage: falling_sand_headless [options]\n"
+        << "  --rows N          Grid rows (default 180)\n"
+        << "  --cols N          Grid columns (default 320)\n"
+        << "  --ticks N         Ticks to simulate (default 1000)\n"
+        << "  --seed N          Random seed (default " << World::DEFAULT_SEED << ")\n"
+        << "  --threads N       Threads, 0 for all hardware threads (default 0)\n"
+        << "  --batched         Update each chunk row in per-type batches\n"
+        << "  --engine NAME     objects (default) or compact (packed 32-bit cells, single-threaded)\n"
+        << "  --trace FILE      Write the last ticks' timeline as a Chrome trace\n"
+        << "  --scenario NAME   Initial layout (default mixed):";
+    for (const std::string& name : Scenarios::getNames()) {
+        out << " " << name;
+    }
+    out << "\n  --help            Show this message\n";
+}
+
+/**
+ * @brief Parses the command line. Throws std::invalid_argument on bad input.
+ */
+static HeadlessOptions parseOptions(int argc, char** argv) {
+    HeadlessOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            options.showHelp = true;
+            continue;
+        }
+        if (arg == "--batched") {
+            options.batchByType = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            throw std::invalid_argument("Missing value for " + arg);
+        }
+        const std::string value = argv[++i];
+
+        if (arg == "--rows")          { options.rows = std::stoi(value); }
+        else if (arg == "--cols")     { options.cols = std::stoi(value); }
+        else if (arg == "--ticks")    { options.ticks = std::stoi(value); }
+        else if (arg == "--threads")  { options.threads = std::stoi(value); }
+        else if (arg == "--seed")     { options.seed = std::stoull(value); }
+        else if (arg == "--scenario") { options.scenario = value; }
+        else if (arg == "--trace")    { options.tracePath = value; }
+        else if (arg == "--engine")   { options.engine = value; }
+        else {
+            throw std::invalid_argument("Unknown option: " + arg);
+        }
+    }
+    if (options.ticks < 0) {
+        throw std::invalid_argument("--ticks must not be negative.");
+    }
+    if (options.engine != "objects" && options.engine != "compact") {
+        throw std::invalid_argument("Unknown engine: " + options.engine);
+    }
+    return options;
+}
+
+/**
+ * @brief Runs the scenario on a CompactWorld and prints its throughput and memory use.
+ */
+static void runCompact(const HeadlessOptions& options) {
+    CompactWorld world(options.rows, options.cols, options.seed);
+    Scenarios::apply(world, options.scenario);
+
+    std::cout << "Scenario: " << options.scenario << "  Grid: " << options.cols << "x" << options.rows
+              << "  Seed: " << options.seed << "  Engine: compact (single-threaded)" << std::endl;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < options.ticks; ++tick) {
+        world.update();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    const double seconds = elapsed.count();
+    const double ticksPerSecond = seconds > 0.0 ? options.ticks / seconds : 0.0;
+    std::cout << "Ticks: " << options.ticks << " in " << seconds << " s\n"
+              << "Ticks/sec: " << ticksPerSecond << "\n"
+              << "Cells/sec: " << ticksPerSecond * options.rows * options.cols << "\n"
+              << "Awake cells at end: " << world.getAwakeCellCount() << "\n"
+              << "Active chunks last tick: " << world.getActiveChunkCount() << "\n"
+              << "Grid memory: " << world.getMemoryBytes() / (1024.0 * 1024.0) << " MB" << std::endl;
+}
+
+/**
+ * @brief Main entry point of the headless runner.
+ */
+int main(int argc, char** argv)
+{
+    HeadlessOptions options;
+    try {
+        options = parseOptions(argc, argv);
+    }
+    catch (const std::exception& e) { // std::stoi throws invalid_argument/out_of_range too
+        std::cerr << "[ERROR] " << e.what() << "\n";
+        printUsage(std::cerr);
+        return 1;
+    }
+    if (options.showHelp) {
+        printUsage(std::cout);
+        return 0;
+    }
+
+    try {
+        // --- Setup ---
+        FS_TRACE_THREAD_NAME("Main");
+        if (options.engine == "compact") {
+            runCompact(options);
+            return 0;
+        }
+        World world(options.rows, options.cols, options.seed);
+        std::unique_ptr<JobSystem> jobs;
+        if (options.threads != 1) {
+            jobs = std::make_unique<JobSystem>(options.threads);
+            world.setJobSystem(jobs.get());
+        }
+        world.setBatchByType(options.batchByType);
+        Scenarios::apply(world, options.scenario);
+        Profiler profiler;
+        world.setProfiler(&profiler);
+
+        std::cout << "Scenario: " << options.scenario << "  Grid: " << options.cols << "x" << options.rows
+                  << "  Seed: " << options.seed << "  Threads: " << world.getThreadCount()
+                  << "  Order: " << (options.batchByType ? "batched by type" : "rows") << std::endl;
+
+        // --- Run ---
+        const auto start = std::chrono::steady_clock::now();
+        for (int tick = 0; tick < options.ticks; ++tick) {
+            world.update();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        // --- Report ---
+        const double seconds = elapsed.count();
+        const double ticksPerSecond = seconds > 0.0 ? options.ticks / seconds : 0.0;
+        const double cellsPerSecond = ticksPerSecond * options.rows * options.cols;
+        std::cout << "Ticks: " << options.ticks << " in " << seconds << " s\n"
+                  << "Ticks/sec: " << ticksPerSecond << "\n"
+                  << "Cells/sec: " << cellsPerSecond << "\n"
+                  << "Awake cells at end: " << world.getAwakeCellCount() << "\n"
+                  << "Last " << Profiler::WINDOW_SIZE << " ticks by phase:\n" << profiler.formatReport()
+                  << "Events over the run:\n" << world.getTotalStats().formatReport() << std::flush;
+
+        if (!options.tracePath.empty()) {
+            if (Trace::ENABLED) {
+                const std::size_t events = Trace::writeChromeTrace(options.tracePath);
+                std::cout << "Trace: " << events << " events written to " << options.tracePath << std::endl;
+            }
+            else {
+                std::cout << "Trace: not written, tracing is compiled out (FALLING_SAND_ENABLE_TRACE=0)" << std::endl;
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[FATAL ERROR] Exception caught in headless runner: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
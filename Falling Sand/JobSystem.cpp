@@ -0,0 +1,203 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        JobSystem.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.1
+// Description: Implementation file for the JobSystem class.
+// ============================================================================
+
+#include "JobSystem.h"
+#include "Trace.h"
+#include <algorithm>
+#include <memory>
+
+// **=== Thread-Local State ===**
+
+namespace {
+    /** @brief Queue index of the calling thread (0 for non-worker threads). */
+    thread_local int tls_workerIndex = 0;
+
+    /** @brief Job currently executing on this thread, used to parent split range jobs. */
+    thread_local Job* tls_currentJob = nullptr;
+
+    /**
+     * @brief Per-thread ring of job slots. Slots are reused once the ring wraps,
+     * so no more than MAX_JOBS_PER_THREAD jobs from one thread may be live at once.
+     */
+    struct JobRing {
+        std::unique_ptr<Job[]> jobs;
+        unsigned int next = 0;
+    };
+    thread_local JobRing tls_jobRing;
+
+    /** @brief Steal attempts a worker makes (yielding between them) before sleeping. */
+    constexpr int IDLE_SPINS_BEFORE_SLEEP = 64;
+}
+
+// **=== Constructors & Destructors ===**
+
+JobSystem::JobSystem(int threadCount)
+    : m_queues(static_cast<std::size_t>(threadCount >= 1 ? threadCount : std::max(1u, std::thread::hardware_concurrency())))
+{
+    for (JobQueue& queue : m_queues) {
+        queue.ring.resize(MAX_JOBS_PER_THREAD);
+    }
+    m_workers.reserve(m_queues.size() - 1);
+    for (int i = 1; i < static_cast<int>(m_queues.size()); ++i) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this, i);
+    }
+}
+
+JobSystem::~JobSystem() {
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_stopping.store(true);
+    }
+    m_wakeWorkers.notify_all();
+    for (std::thread& worker : m_workers) {
+        worker.join();
+    }
+}
+
+// **=== Public Methods ===**
+
+void JobSystem::run(Job* job) {
+    JobQueue& queue = m_queues[tls_workerIndex];
+    if (!queue.push(job)) {
+        execute(job); // Deque full: just run it here rather than drop it
+        return;
+    }
+    m_queuedJobs.fetch_add(1); // seq_cst pairs with the sleeping-worker count below
+
+    // Only pay for the lock/notify if somebody is actually asleep
+    if (m_sleepingWorkers.load() > 0) {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_wakeWorkers.notify_one();
+    }
+}
+
+void JobSystem::wait(Job* job) {
+    while (job->m_unfinished.load(std::memory_order_acquire) > 0) {
+        if (Job* other = findJob()) {
+            execute(other); // Help out instead of blocking
+        }
+        else {
+            std::this_thread::yield();
+        }
+    }
+}
+
+int JobSystem::currentWorkerIndex() {
+    return tls_workerIndex;
+}
+
+// **=== Private Methods ===**
+
+Job* JobSystem::allocateJob(Job* parent) {
+    JobRing& ring = tls_jobRing;
+    if (!ring.jobs) {
+        ring.jobs = std::make_unique<Job[]>(MAX_JOBS_PER_THREAD);
+    }
+    Job* job = &ring.jobs[ring.next++ % MAX_JOBS_PER_THREAD];
+
+    job->m_parent = parent;
+    job->m_unfinished.store(1, std::memory_order_relaxed);
+    if (parent) {
+        parent->m_unfinished.fetch_add(1, std::memory_order_relaxed);
+    }
+    return job;
+}
+
+Job* JobSystem::findJob() {
+    // Own deque first (newest work, still warm in cache)
+    const int self = tls_workerIndex;
+    if (Job* job = m_queues[self].pop()) {
+        m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+    }
+
+    // Then steal the oldest work from everyone else, starting after ourselves
+    const int queueCount = static_cast<int>(m_queues.size());
+    for (int i = 1; i < queueCount; ++i) {
+        if (Job* job = m_queues[(self + i) % queueCount].steal()) {
+            m_queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+void JobSystem::execute(Job* job) {
+    Job* previous = tls_currentJob;
+    tls_currentJob = job;
+    job->m_function(*job);
+    tls_currentJob = previous;
+    finish(job);
+}
+
+void JobSystem::finish(Job* job) {
+    if (job->m_unfinished.fetch_sub(1, std::memory_order_acq_rel) == 1 && job->m_parent) {
+        finish(job->m_parent);
+    }
+}
+
+Job* JobSystem::currentJob() const {
+    return tls_currentJob;
+}
+
+void JobSystem::workerLoop(int index) {
+    tls_workerIndex = index;
+    FS_TRACE_THREAD_NAME("Worker " + std::to_string(index));
+    int idleSpins = 0;
+
+    while (!m_stopping.load(std::memory_order_acquire)) {
+        if (Job* job = findJob()) {
+            execute(job);
+            idleSpins = 0;
+            continue;
+        }
+
+        if (++idleSpins < IDLE_SPINS_BEFORE_SLEEP) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // Nothing to do for a while: sleep until a job is queued
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepingWorkers.fetch_add(1);
+        m_wakeWorkers.wait(lock, [this] {
+            return m_stopping.load() || m_queuedJobs.load() > 0;
+        });
+        m_sleepingWorkers.fetch_sub(1);
+        idleSpins = 0;
+    }
+}
+
+// **=== Job Queue ===**
+
+bool JobSystem::JobQueue::push(Job* job) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tail - head >= ring.size()) {
+        return false;
+    }
+    ring[tail++ % ring.size()] = job;
+    return true;
+}
+
+Job* JobSystem::JobQueue::pop() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tail == head) {
+        return nullptr;
+    }
+    return ring[--tail % ring.size()];
+}
+
+Job* JobSystem::JobQueue::steal() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (tail == head) {
+        return nullptr;
+    }
+    return ring[head++ % ring.size()];
+}
\ No newline at end of file
@@ -0,0 +1,260 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        JobSystem.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.1
+// Description: Header file for the JobSystem class.
+//              A work-stealing task scheduler: every worker owns a job deque,
+//              idle workers steal from the others, jobs can have a parent
+//              that only completes once all its children have, and
+//              parallelFor splits index ranges into stealable halves.
+// ============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+class JobSystem;
+
+/**
+ * @brief A unit of work. Created by JobSystem::createJob(), never directly.
+ *
+ * The callable is stored inline in a small payload buffer, so creating and
+ * running a job does not allocate. Jobs come from a per-thread ring buffer.
+ */
+class alignas(64) Job {
+public:
+    /** @brief Bytes available to store the job's callable (captures). */
+    static constexpr std::size_t PAYLOAD_SIZE = 40;
+
+private:
+    friend class JobSystem;
+    using Function = void (*)(Job&);
+
+    Function m_function = nullptr;
+    Job* m_parent = nullptr;
+    /** @brief 1 for the job itself plus 1 for every child not yet finished. */
+    std::atomic<int> m_unfinished{ 0 };
+    alignas(void*) unsigned char m_payload[PAYLOAD_SIZE];
+};
+static_assert(sizeof(Job) == 64, "Job should fill exactly one cache line.");
+
+/**
+ * @brief Work-stealing job scheduler.
+ *
+ * threadCount - 1 worker threads are started. The thread that calls wait()
+ * or parallelFor() (normally the main thread) also executes jobs while it
+ * waits, so threadCount threads are busy in total. Each worker pushes and pops
+ * its own deque LIFO; thieves take the oldest (largest) work FIFO from others.
+ * Threads that are not workers share deque 0.
+ */
+class JobSystem {
+public:
+    // **=== Constants ===**
+    /** @brief Jobs each thread can have in flight before its job ring wraps around. */
+    static constexpr int MAX_JOBS_PER_THREAD = 4096;
+
+    // **=== Constructors & Destructors ===**
+
+    /**
+     * @brief Starts the worker threads.
+     * @param threadCount Total threads including the caller. Values < 1 use
+     *        std::thread::hardware_concurrency().
+     */
+    explicit JobSystem(int threadCount = 0);
+
+    /**
+     * @brief Stops and joins all workers. Outstanding jobs must already be finished.
+     */
+    ~JobSystem();
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Creates a job that runs a callable. The job is not started until run().
+     * @param function Callable taking no arguments. Must be trivially copyable and fit
+     *        in Job::PAYLOAD_SIZE (e.g. a lambda capturing a few pointers/references).
+     * @param parent Optional parent; the parent does not count as finished until this job is.
+     * @return Job* The new job.
+     */
+    template <typename F>
+    Job* createJob(const F& function, Job* parent = nullptr) {
+        static_assert(sizeof(F) <= Job::PAYLOAD_SIZE, "Job callable is too large for the inline payload.");
+        static_assert(std::is_trivially_copyable_v<F>, "Job callable must be trivially copyable.");
+        static_assert(alignof(F) <= alignof(void*), "Job callable is over-aligned for the inline payload.");
+        Job* job = allocateJob(parent);
+        ::new (job->m_payload) F(function);
+        job->m_function = [](Job& self) {
+            (*std::launder(reinterpret_cast<F*>(self.m_payload)))();
+        };
+        return job;
+    }
+
+    /**
+     * @brief Queues a job on the calling thread's deque.
+     * @param job The job to run.
+     */
+    void run(Job* job);
+
+    /**
+     * @brief Blocks until a job (and all of its children) has finished.
+     * The calling thread runs other queued jobs while it waits.
+     * @param job The job to wait for.
+     */
+    void wait(Job* job);
+
+    /**
+     * @brief Calls function(begin, end) over sub-ranges covering [first, last), in parallel.
+     * The range is split in halves recursively until pieces are no larger than the
+     * grain size, so idle threads can steal large halves. Blocks until done.
+     *
+     * The grain is a lower bound, not the piece size: it is raised to
+     * count / (threadCount * 8) when that is larger, so a call never makes more than
+     * about 8 leaf jobs per thread and the job rings (MAX_JOBS_PER_THREAD) cannot
+     * wrap onto live jobs, however long the range.
+     * @param first First index.
+     * @param last One past the last index.
+     * @param grain Smallest range worth a job of its own (see above).
+     * @param function Callable (int begin, int end). Must be safe to call concurrently.
+     */
+    template <typename F>
+    void parallelFor(int first, int last, int grain, const F& function) {
+        const int count = last - first;
+        if (count <= 0) {
+            return;
+        }
+        // Keep ~8 leaf jobs per thread at most, so the job rings never wrap onto live jobs
+        const int minGrain = (count + getThreadCount() * 8 - 1) / (getThreadCount() * 8);
+        grain = grain > minGrain ? grain : minGrain;
+        if (count <= grain || getThreadCount() == 1) {
+            function(first, last);
+            return;
+        }
+
+        Job* root = createRangeJob(&function, first, last, grain, nullptr);
+        run(root);
+        wait(root);
+    }
+
+    /**
+     * @brief Gets the total number of threads that execute jobs (workers plus the caller).
+     * @return int The thread count.
+     */
+    int getThreadCount() const { return static_cast<int>(m_queues.size()); }
+
+    /**
+     * @brief Gets the index of the calling thread: 1..threadCount-1 for workers, 0 for any other thread.
+     * @return int The worker index.
+     */
+    static int currentWorkerIndex();
+
+private:
+    // **=== Private Types ===**
+
+    /**
+     * @brief Fixed-capacity job deque. Owner pushes/pops at the back, thieves take from the front.
+     */
+    struct alignas(64) JobQueue {
+        std::mutex mutex;
+        std::vector<Job*> ring;
+        std::size_t head = 0; // Index of the oldest job
+        std::size_t tail = 0; // One past the newest job
+
+        bool push(Job* job);
+        Job* pop();
+        Job* steal();
+    };
+
+    /**
+     * @brief Payload of a parallelFor range job.
+     */
+    template <typename F>
+    struct RangeTask {
+        JobSystem* system;
+        const F* function;
+        int begin;
+        int end;
+        int grain;
+
+        void operator()() const {
+            if (end - begin > grain) {
+                // Split in half; both halves become children of the currently running job
+                const int mid = begin + (end - begin) / 2;
+                Job* self = system->currentJob();
+                system->run(system->createRangeJob(function, begin, mid, grain, self));
+                system->run(system->createRangeJob(function, mid, end, grain, self));
+            }
+            else {
+                (*function)(begin, end);
+            }
+        }
+    };
+
+    // **=== Private Members ===**
+    std::vector<std::thread> m_workers;
+    /** @brief One deque per thread slot; slot 0 is shared by all non-worker threads. */
+    std::vector<JobQueue> m_queues;
+
+    // -- Idle handling --
+    std::mutex m_sleepMutex;
+    std::condition_variable m_wakeWorkers;
+    std::atomic<int> m_queuedJobs{ 0 };
+    std::atomic<int> m_sleepingWorkers{ 0 };
+    std::atomic<bool> m_stopping{ false };
+
+    // **=== Private Methods ===**
+
+    template <typename F>
+    Job* createRangeJob(const F* function, int begin, int end, int grain, Job* parent) {
+        return createJob(RangeTask<F>{ this, function, begin, end, grain }, parent);
+    }
+
+    /**
+     * @brief Takes the next job slot from the calling thread's ring and initialises it.
+     * @param parent Parent job or nullptr.
+     * @return Job* The job.
+     */
+    Job* allocateJob(Job* parent);
+
+    /**
+     * @brief Finds a job: own deque first, then steals from the others.
+     * @return Job* A job, or nullptr if none were available.
+     */
+    Job* findJob();
+
+    /**
+     * @brief Runs a job and marks it finished.
+     * @param job The job to execute.
+     */
+    void execute(Job* job);
+
+    /**
+     * @brief Decrements a job's unfinished count, propagating to the parent when it hits zero.
+     * @param job The job.
+     */
+    void finish(Job* job);
+
+    /**
+     * @brief Gets the job currently executing on this thread (used by RangeTask to parent its children).
+     * @return Job* The running job, or nullptr.
+     */
+    Job* currentJob() const;
+
+    /**
+     * @brief Main loop of each worker thread.
+     * @param index The worker's queue index (1..threadCount-1).
+     */
+    void workerLoop(int index);
+};
\ No newline at end of file
@@ -3,8 +3,8 @@
 // File:        Liquid.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-26
-// Last Update: 2025-04-26
-// Version:     1.4
+// Last Update: 2026-10-16
+// Version:     1.8
 // Description: Implementation file for the Liquid abstract class.
 //              Contains common logic shared by all liquid elements,
 //              including flow and evaporation behaviours.
@@ -12,12 +12,9 @@
 
 #include "Liquid.h"
 #include "World.h"
-#include "Gas.h"
 #include "Particle.h"
-#include <cstdlib>
 #include <utility>
 #include <memory>
-#include "Solid.h"
 
 // **=== Protected Helper Methods ===**
 
@@ -29,7 +26,8 @@ bool Liquid::attemptFlow(World& world, int r, int c) {
     }
 
     // --- Priority 2: Try Move/Swap Diagonals Down ---
-    int diag_dir = (rand() % 2 == 0) ? 1 : -1; // Randomize diagonal check order
+    Random& rng = world.getRandom(r, c);
+    int diag_dir = rng.nextDirection(); // Randomize diagonal check order
     // Try preferred diagonal
     if (world.tryMoveOrSwap(r, c, r + 1, c + diag_dir)) {
         return true;
@@ -41,10 +39,11 @@ bool Liquid::attemptFlow(World& world, int r, int c) {
 
     // --- Priority 3: Check Horizontal (Yielding to Denser Falling) ---
     int dispersion = this->getDispersionRate();
+    const float ownDensity = getTraits().density;
     int best_h_move_c = c;      // Target column, c means no move found yet
     int min_dist = dispersion + 1; // Distance to closest valid spot
 
-    int horiz_dir = (rand() % 2 == 0) ? 1 : -1; // Randomize side check order
+    int horiz_dir = rng.nextDirection(); // Randomize side check order
 
     for (int i = 0; i < 2; ++i) { // Check both L/R directions
         for (int step = 1; step <= dispersion; ++step) {
@@ -60,22 +59,13 @@ bool Liquid::attemptFlow(World& world, int r, int c) {
             bool yieldToElementAbove = false;
             Element* aboveTarget = world.getElement(check_r - 1, check_c); // Check cell *above* the potential target
 
-            if (aboveTarget) { // If there is something above the target...
-                // Get the density of the element
-                float aboveTargetDensity = 0.0f;
-                bool densityObtained = false;
-                if (Solid* solidAbove = dynamic_cast<Solid*>(aboveTarget)) { aboveTargetDensity = solidAbove->getDensity(); densityObtained = true; }
-                else if (Liquid* liquidAbove = dynamic_cast<Liquid*>(aboveTarget)) { aboveTargetDensity = liquidAbove->getDensity(); densityObtained = true; }
-                else if (Gas* gasAbove = dynamic_cast<Gas*>(aboveTarget)) { aboveTargetDensity = gasAbove->getDensity(); densityObtained = true; }
-
-                // Check if the element above has density AND is denser than this liquid
-                if (densityObtained && aboveTargetDensity > this->getDensity()) {
-                    yieldToElementAbove = true; // Yield to the denser falling element
-                }
+            // If there is something above the target that is denser than this liquid, yield to it
+            if (aboveTarget && aboveTarget->getTraits().density > ownDensity) {
+                yieldToElementAbove = true; // Yield to the denser falling element
             }
 
-            // Check if target spot in nextGrid is already claimed OR if we should yield
-            if (world.getElementFromNext(check_r, check_c) || yieldToElementAbove) {
+            // Check if target spot is already claimed this tick OR if we should yield
+            if (world.isClaimedThisTick(check_r, check_c) || yieldToElementAbove) {
                 // If claimed OR denser element is above, water cannot flow here horizontally this step.
                 break; // Stop checking further in this direction
             }
@@ -129,7 +119,7 @@ bool Liquid::attemptEvaporation(World& world, int r, int c) {
 
     // Allow evaporation into empty space or existing gas
     // TODO: Could refine this - maybe only if the gas above is the *same* gas type?
-    bool spaceAbove = !elementAbove || dynamic_cast<Gas*>(elementAbove);
+    bool spaceAbove = !elementAbove || elementAbove->getTraits().phase == MatterPhase::Gas;
 
     if (!spaceAbove) {
         return false; // Blocked above
@@ -137,7 +127,8 @@ bool Liquid::attemptEvaporation(World& world, int r, int c) {
 
     // 3. Probability Check (default 20% chance per tick if conditions met)
     const int EVAPORATION_CHANCE = 20; // Percent
-    if ((rand() % 100) >= EVAPORATION_CHANCE) {
+    Random& rng = world.getRandom(r, c);
+    if (!rng.chance(EVAPORATION_CHANCE)) {
         return false; // Didn't evaporate this tick
     }
 
@@ -147,14 +138,7 @@ bool Liquid::attemptEvaporation(World& world, int r, int c) {
         return false; // Cannot evaporate if no gas form specified
     }
 
-    // Create the new gas element using the world's factory
-    std::unique_ptr<Element> newGasElement = world.createElementByType(gasType);
-
-    if (newGasElement) {
-        // Place the new gas element into the NEXT grid at the current position
-        world.setNextElement(r, c, std::move(newGasElement));
-        return true; // Evaporation successful
-    }
-
-    return false; // Failed to create gas element
+    // Turn this liquid into the gas in place (false if the gas has no element class yet).
+    // On success this object is gone, so the caller must not touch it again.
+    return world.morphElement(r, c, gasType);
 }
\ No newline at end of file
@@ -3,8 +3,8 @@
 // File:        Liquid.h
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-26
-// Version:     1.3
+// Last Update: 2026-10-16
+// Version:     1.6
 // Description: Header file for the Liquid abstract class.
 //              Inherits from Element and serves as a base for all liquid
 //              particle types. Defines common liquid properties (density,
@@ -28,7 +28,13 @@ class World;
  */
 class Liquid : public Element {
 public:
-    // **=== Destructor ===**
+    // **=== Constructors & Destructor ===**
+
+    /**
+     * @brief Constructs a liquid element.
+     * @param type The concrete element's ParticleType.
+     */
+    explicit Liquid(ParticleType type) : Element(type) {}
 
     /**
      * @brief Virtual destructor. Ensures proper cleanup for derived classes.
@@ -51,15 +57,9 @@ public:
 
     /**
      * @brief Gets the display color of this liquid element.
-     * @return sf::Color The color for rendering.
-     */
-    virtual sf::Color getColor() const = 0;
-
-    /**
-     * @brief Gets the specific type identifier for this liquid element.
-     * @return ParticleType The enum value (e.g., ParticleType::WATER).
+     * @return Color The color for rendering.
      */
-    virtual ParticleType getType() const = 0;
+    virtual Color getColor() const = 0;
 
     /**
      * @brief Gets the density of this liquid element. Crucial for buoyancy
@@ -130,7 +130,7 @@ protected:
      * @param world Reference to the world grid.
      * @param r Current row.
      * @param c Current column.
-     * @return true if evaporation occurred and element was replaced, false otherwise.
+     * @return true if the liquid turned into its gas form in place (this object is then gone), false otherwise.
      */
     virtual bool attemptEvaporation(World& world, int r, int c); // Declaration only
 
@@ -0,0 +1,522 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        MicroBenchmarkMain.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.5
+// Description: Main entry point for the micro benchmarks.
+//              Times the World interaction primitives that every element
+//              update leans on (moves, wakes, lookups, element creation,
+//              liquid flow, grid painting) in isolation, on fixed-seed
+//              fixtures, so hot-path regressions show up per function.
+// ============================================================================
+
+#include "World.h"
+#include "ColorPlane.h"
+#include "JobSystem.h"
+#include "Scenarios.h"
+#include "WaterElement.h"
+#include "Utils.h"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifdef FALLING_SAND_HAS_SFML
+#include "GridRenderer.h"
+#endif
+
+// **=== World Access ===**
+
+/**
+ * @brief Runs single steps of World::update() so fixtures can be reset between timed batches.
+ * Declared a friend by World.
+ */
+struct WorldBenchmarkAccess {
+    /** @brief Starts a new tick without sweeping: applies wakes and clears every claim. */
+    static void beginTick(World& world) {
+        world.applyWakeRequests();
+        world.advanceTickEpoch();
+    }
+
+    /** @brief Finishes a tick: frees replaced elements and rescans emptied column tops. */
+    static void endTick(World& world) {
+        world.releaseRetiredElements();
+        world.resolveStaleSegments();
+    }
+
+    static void requestWake(World& world, int r, int c, int radius) { world.requestWake(r, c, radius); }
+    static void applyWakeRequests(World& world) { world.applyWakeRequests(); }
+};
+
+using Access = WorldBenchmarkAccess;
+
+// **=== Timing ===**
+
+/**
+ * @brief Accumulates the time and operation count of the timed sections of one run.
+ */
+class MicroTimer {
+public:
+    void start() { m_start = Clock::now(); }
+    void stop(std::size_t ops) {
+        m_elapsedNs += std::chrono::duration<double, std::nano>(Clock::now() - m_start).count();
+        m_ops += ops;
+    }
+    double getElapsedNs() const { return m_elapsedNs; }
+    std::size_t getOps() const { return m_ops; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point m_start;
+    double m_elapsedNs = 0.0;
+    std::size_t m_ops = 0;
+};
+
+/**
+ * @brief A named benchmark. run() builds its fixture and times only the primitive under test.
+ */
+struct MicroBenchmark {
+    std::string name;
+    std::function<void(MicroTimer&)> run;
+};
+
+/**
+ * @brief Summary of all repeats of one benchmark.
+ */
+struct MicroResult {
+    std::string name;
+    double medianNsPerOp = 0.0;
+    double minNsPerOp = 0.0;
+    std::size_t opsPerRun = 0;
+};
+
+/** @brief Results are folded in here so the optimiser cannot drop the calls being timed. */
+static volatile std::uint64_t g_sink = 0;
+
+/** @brief Seed of every fixture, so runs are comparable. */
+static constexpr std::uint64_t FIXTURE_SEED = 12345;
+
+// **=== Fixtures ===**
+
+/**
+ * @brief Water with an adjustable dispersion rate, exposing Liquid::attemptFlow().
+ */
+class FlowWater : public WaterElement {
+public:
+    explicit FlowWater(int dispersion) : m_dispersion(dispersion) {}
+    int getDispersionRate() const override { return m_dispersion; }
+    using Liquid::attemptFlow;
+
+private:
+    int m_dispersion;
+};
+
+/**
+ * @brief Fills a whole row with one type.
+ */
+static void fillRow(World& world, int r, ParticleType type) {
+    for (int c = 0; c < world.getCols(); ++c) {
+        world.setElementByType(r, c, type);
+    }
+}
+
+/**
+ * @brief tryMoveOrSwap() from every cell of row 0 into row 1, in batches that
+ * reset the two rows (and the claims) between them. Only the moves are timed.
+ */
+static void benchMoveBatches(MicroTimer& timer, ParticleType mover, ParticleType target) {
+    constexpr int COLS = 1024;
+    constexpr int BATCHES = 64;
+    World world(2, COLS, FIXTURE_SEED);
+    for (int batch = 0; batch < BATCHES; ++batch) {
+        fillRow(world, 0, mover);
+        fillRow(world, 1, target);
+        Access::endTick(world);
+        Access::beginTick(world);
+
+        std::uint64_t moved = 0;
+        timer.start();
+        for (int c = 0; c < COLS; ++c) {
+            moved += world.tryMoveOrSwap(0, c, 1, c);
+        }
+        timer.stop(COLS);
+        g_sink = g_sink + moved;
+    }
+}
+
+/**
+ * @brief tryMoveOrSwap() calls that fail and change nothing, so the same fixture is reused.
+ * @param claimFirst Claim every target with an untimed move from row 0 first.
+ */
+static void benchFailedMoves(MicroTimer& timer, ParticleType top, ParticleType middle, ParticleType bottom, bool claimFirst) {
+    constexpr int COLS = 1024;
+    constexpr int PASSES = 256;
+    World world(3, COLS, FIXTURE_SEED);
+    fillRow(world, 0, top);
+    fillRow(world, 1, middle);
+    fillRow(world, 2, bottom);
+    Access::beginTick(world);
+    if (claimFirst) {
+        for (int c = 0; c < COLS; ++c) {
+            world.tryMoveOrSwap(0, c, 1, c);
+        }
+    }
+
+    std::uint64_t moved = 0;
+    timer.start();
+    for (int pass = 0; pass < PASSES; ++pass) {
+        for (int c = 0; c < COLS; ++c) {
+            moved += world.tryMoveOrSwap(2, c, 1, c);
+        }
+    }
+    timer.stop(static_cast<std::size_t>(PASSES) * COLS);
+    g_sink = g_sink + moved;
+}
+
+/**
+ * @brief Liquid::attemptFlow() for drops resting on a floor with room to spread sideways.
+ * Drops are spaced so their sideways reach never overlaps.
+ */
+static void benchFlow(MicroTimer& timer, int dispersion) {
+    constexpr int COLS = 1024;
+    constexpr int BATCHES = 64;
+    const int spacing = dispersion * 2 + 2;
+    World world(3, COLS, FIXTURE_SEED);
+    fillRow(world, 2, ParticleType::DIRT);
+
+    for (int batch = 0; batch < BATCHES; ++batch) {
+        fillRow(world, 1, ParticleType::EMPTY);
+        for (int c = dispersion; c < COLS; c += spacing) {
+            world.replaceElement(1, c, ElementPtr(new FlowWater(dispersion)));
+        }
+        Access::endTick(world);
+        Access::beginTick(world);
+
+        std::uint64_t moved = 0;
+        std::size_t drops = 0;
+        timer.start();
+        for (int c = dispersion; c < COLS; c += spacing) {
+            moved += static_cast<FlowWater*>(world.getElement(1, c))->attemptFlow(world, 1, c);
+            ++drops;
+        }
+        timer.stop(drops);
+        g_sink = g_sink + moved;
+    }
+}
+
+// **=== Benchmark List ===**
+
+static std::vector<MicroBenchmark> makeBenchmarks() {
+    std::vector<MicroBenchmark> benchmarks;
+
+    // -- tryMoveOrSwap, one case each --
+    benchmarks.push_back({ "tryMoveOrSwap/empty_target", [](MicroTimer& timer) {
+        benchMoveBatches(timer, ParticleType::SAND, ParticleType::EMPTY);
+    } });
+    benchmarks.push_back({ "tryMoveOrSwap/fluid_swap", [](MicroTimer& timer) {
+        benchMoveBatches(timer, ParticleType::SAND, ParticleType::WATER);
+    } });
+    benchmarks.push_back({ "tryMoveOrSwap/claimed_target", [](MicroTimer& timer) {
+        benchFailedMoves(timer, ParticleType::SAND, ParticleType::EMPTY, ParticleType::SAND, true);
+    } });
+    benchmarks.push_back({ "tryMoveOrSwap/blocked", [](MicroTimer& timer) {
+        benchFailedMoves(timer, ParticleType::EMPTY, ParticleType::DIRT, ParticleType::SAND, false);
+    } });
+
+    // -- Wakes (requestWake + applyWakeRequests replaced wakeNeighbors) --
+    benchmarks.push_back({ "wake/requestWake", [](MicroTimer& timer) {
+        World world(256, 1024, FIXTURE_SEED);
+        Scenarios::apply(world, "static");
+        for (int batch = 0; batch < 16; ++batch) {
+            std::size_t requests = 0;
+            timer.start();
+            for (int r = batch % 4; r < world.getRows(); r += 4) {
+                for (int c = batch % 3; c < world.getCols(); c += 3) {
+                    Access::requestWake(world, r, c, World::DEFAULT_WAKE_RADIUS);
+                    ++requests;
+                }
+            }
+            timer.stop(requests);
+            Access::applyWakeRequests(world);
+        }
+    } });
+    benchmarks.push_back({ "wake/applyWakeRequests_per_request", [](MicroTimer& timer) {
+        World world(256, 1024, FIXTURE_SEED);
+        Scenarios::apply(world, "static");
+        for (int batch = 0; batch < 16; ++batch) {
+            std::size_t requests = 0;
+            for (int r = batch % 4; r < world.getRows(); r += 4) {
+                for (int c = batch % 3; c < world.getCols(); c += 3) {
+                    Access::requestWake(world, r, c, World::DEFAULT_WAKE_RADIUS);
+                    ++requests;
+                }
+            }
+            timer.start();
+            Access::applyWakeRequests(world);
+            timer.stop(requests);
+        }
+    } });
+
+    // -- Lookups over a fully occupied random grid --
+    benchmarks.push_back({ "getElement", [](MicroTimer& timer) {
+        World world(256, 1024, FIXTURE_SEED);
+        Scenarios::apply(world, "allawake");
+        std::uint64_t found = 0;
+        timer.start();
+        for (int pass = 0; pass < 8; ++pass) {
+            for (int r = 0; r < world.getRows(); ++r) {
+                for (int c = 0; c < world.getCols(); ++c) {
+                    found += world.getElement(r, c) != nullptr;
+                }
+            }
+        }
+        timer.stop(static_cast<std::size_t>(8) * world.getRows() * world.getCols());
+        g_sink = g_sink + found;
+    } });
+    benchmarks.push_back({ "getElementType", [](MicroTimer& timer) {
+        World world(256, 1024, FIXTURE_SEED);
+        Scenarios::apply(world, "allawake");
+        std::uint64_t sum = 0;
+        timer.start();
+        for (int pass = 0; pass < 8; ++pass) {
+            for (int r = 0; r < world.getRows(); ++r) {
+                for (int c = 0; c < world.getCols(); ++c) {
+                    sum += static_cast<std::uint64_t>(world.getElementType(r, c));
+                }
+            }
+        }
+        timer.stop(static_cast<std::size_t>(8) * world.getRows() * world.getCols());
+        g_sink = g_sink + sum;
+    } });
+
+    // -- createElementByType for each type (creation timed, freeing is not) --
+    for (ParticleType type : { ParticleType::SAND, ParticleType::DIRT, ParticleType::GRASS, ParticleType::WATER }) {
+        benchmarks.push_back({ "createElementByType/" + Utils::getNameForType(type), [type](MicroTimer& timer) {
+            constexpr std::size_t BATCH = 4096;
+            World world(1, 1, FIXTURE_SEED);
+            std::vector<ElementPtr> elements(BATCH);
+            for (int batch = 0; batch < 32; ++batch) {
+                timer.start();
+                for (std::size_t i = 0; i < BATCH; ++i) {
+                    elements[i] = world.createElementByType(type, 0, static_cast<int>(i));
+                }
+                timer.stop(BATCH);
+                for (ElementPtr& element : elements) {
+                    element.reset(); // Back to the pool, untimed
+                }
+            }
+        } });
+    }
+
+    // -- Dirt <-> grass over a whole row: in place vs a new element per change --
+    for (bool inPlace : { true, false }) {
+        benchmarks.push_back({ std::string(inPlace ? "morphElement" : "replaceElement") + "/dirt_grass", [inPlace](MicroTimer& timer) {
+            World world(1, 4096, FIXTURE_SEED);
+            fillRow(world, 0, ParticleType::DIRT);
+            for (int batch = 0; batch < 32; ++batch) {
+                const ParticleType type = batch % 2 == 0 ? ParticleType::GRASS : ParticleType::DIRT;
+                Access::beginTick(world);
+                timer.start();
+                for (int c = 0; c < world.getCols(); ++c) {
+                    if (inPlace) {
+                        world.morphElement(0, c, type);
+                    }
+                    else {
+                        world.replaceElement(0, c, world.createElementByType(type, 0, c));
+                    }
+                }
+                timer.stop(static_cast<std::size_t>(world.getCols()));
+                Access::endTick(world); // Frees the replaced elements, untimed
+            }
+        } });
+    }
+
+    // -- Liquid::attemptFlow at several dispersion rates (Water uses 7) --
+    for (int dispersion : { 1, 2, 4, 7, 10 }) {
+        benchmarks.push_back({ "Liquid::attemptFlow/dispersion_" + std::to_string(dispersion), [dispersion](MicroTimer& timer) {
+            benchFlow(timer, dispersion);
+        } });
+    }
+
+    // -- Painting the pixels of a full 320x180 grid (the Game's grid), per frame --
+    benchmarks.push_back({ "ColorPlane::fill/320x180_full", [](MicroTimer& timer) {
+        World world(180, 320, FIXTURE_SEED);
+        Scenarios::apply(world, "allawake");
+        JobSystem jobs(0);
+        ColorPlane plane;
+        plane.fill(world, jobs); // Allocate the plane, untimed
+        timer.start();
+        for (int frame = 0; frame < 32; ++frame) {
+            plane.fill(world, jobs);
+        }
+        timer.stop(32);
+        g_sink = g_sink + plane.getPixel(179, 319).r;
+    } });
+
+    // -- Repainting only what changed: a sand trickle onto settled grass hills --
+    benchmarks.push_back({ "ColorPlane::fillArea/320x180_trickle", [](MicroTimer& timer) {
+        World world(180, 320, FIXTURE_SEED);
+        Scenarios::apply(world, "grassfield");
+        JobSystem jobs(0);
+        ColorPlane plane;
+        std::vector<DirtyRect> areas;
+        for (int tick = 0; tick < 600; ++tick) {
+            world.update(); // Settle the hills, untimed
+        }
+        plane.fill(world, jobs);
+        world.takeChangedAreas(areas);
+        std::size_t cells = 0;
+        for (int frame = 0; frame < 64; ++frame) {
+            world.requestPlacement(0, world.getCols() / 2, ParticleType::SAND);
+            world.update(); // Untimed
+            timer.start();
+            world.takeChangedAreas(areas);
+            for (const DirtyRect& area : areas) {
+                plane.fillArea(world, area);
+                cells += static_cast<std::size_t>(area.maxR - area.minR + 1) * (area.maxC - area.minC + 1);
+            }
+            timer.stop(1);
+        }
+        g_sink = g_sink + cells;
+    } });
+
+#ifdef FALLING_SAND_HAS_SFML
+    // -- Painting and uploading the same grid's texture --
+    benchmarks.push_back({ "GridRenderer::prepareFrame/320x180_full", [](MicroTimer& timer) {
+        World world(180, 320, FIXTURE_SEED);
+        Scenarios::apply(world, "allawake");
+        JobSystem jobs(0);
+        GridRenderer renderer(5.0f);
+        renderer.prepareFrame(world, jobs); // Create the texture, untimed
+        timer.start();
+        for (int frame = 0; frame < 32; ++frame) {
+            renderer.prepareFrame(world, jobs);
+        }
+        timer.stop(32);
+        g_sink = g_sink + renderer.getColorPlane().getPixel(0, 0).r;
+    } });
+#endif
+
+    return benchmarks;
+}
+
+// **=== Output ===**
+
+static void printUsage(std::ostream& out) {
+    out << "Usage: falling_sand_microbench [options]\n"
+        << "  --filter TEXT     Only run benchmarks whose name contains TEXT\n"
+        << "  --repeat N        Runs per benchmark; the median is reported (default 7)\n"
+        << "  --json PATH       JSON output file (default micro_benchmark_results.json)\n"
+        << "  --list            List the benchmarks and exit\n"
+        << "  --help            Show this message\n";
+}
+
+static void writeJson(const std::string& path, int repeat, const std::vector<MicroResult>& results) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Failed to open JSON output: " + path);
+    }
+    out << std::setprecision(6);
+    out << "{\n"
+        << "  \"benchmark\": \"micro\",\n"
+        << "  \"seed\": " << FIXTURE_SEED << ",\n"
+        << "  \"repeat\": " << repeat << ",\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const MicroResult& r = results[i];
+        out << "    { \"name\": \"" << r.name << "\""
+            << ", \"medianNsPerOp\": " << r.medianNsPerOp
+            << ", \"minNsPerOp\": " << r.minNsPerOp
+            << ", \"opsPerRun\": " << r.opsPerRun
+            << " }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+ * @brief Main entry point of the micro benchmarks.
+ */
+int main(int argc, char** argv)
+{
+    std::string filter;
+    std::string jsonPath = "micro_benchmark_results.json";
+    int repeat = 7;
+    bool listOnly = false;
+
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--help" || arg == "-h") { printUsage(std::cout); return 0; }
+            if (arg == "--list") { listOnly = true; continue; }
+            if (i + 1 >= argc) {
+                throw std::invalid_argument("Missing value for " + arg);
+            }
+            const std::string value = argv[++i];
+            if (arg == "--filter")      { filter = value; }
+            else if (arg == "--repeat") { repeat = std::max(1, std::stoi(value)); }
+            else if (arg == "--json")   { jsonPath = value; }
+            else {
+                throw std::invalid_argument("Unknown option: " + arg);
+            }
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[ERROR] " << e.what() << "\n";
+        printUsage(std::cerr);
+        return 1;
+    }
+
+    try {
+        std::vector<MicroResult> results;
+        std::cout << std::left << std::setw(46) << "benchmark" << std::right << std::setw(14) << "median ns/op"
+                  << std::setw(12) << "min ns/op" << std::setw(12) << "ops/run" << "\n";
+        std::cout << std::fixed << std::setprecision(2);
+
+        for (const MicroBenchmark& benchmark : makeBenchmarks()) {
+            if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+                continue;
+            }
+            if (listOnly) {
+                std::cout << benchmark.name << "\n";
+                continue;
+            }
+
+            std::vector<double> nsPerOp;
+            MicroResult result;
+            result.name = benchmark.name;
+            for (int run = 0; run < repeat; ++run) {
+                MicroTimer timer;
+                benchmark.run(timer);
+                result.opsPerRun = timer.getOps();
+                nsPerOp.push_back(timer.getOps() > 0 ? timer.getElapsedNs() / timer.getOps() : 0.0);
+            }
+            std::sort(nsPerOp.begin(), nsPerOp.end());
+            result.medianNsPerOp = nsPerOp[nsPerOp.size() / 2];
+            result.minNsPerOp = nsPerOp.front();
+
+            std::cout << std::left << std::setw(46) << result.name << std::right << std::setw(14) << result.medianNsPerOp
+                      << std::setw(12) << result.minNsPerOp << std::setw(12) << result.opsPerRun << std::endl;
+            results.push_back(std::move(result));
+        }
+
+        if (!listOnly) {
+            writeJson(jsonPath, repeat, results);
+            std::cout << "Results written to " << jsonPath << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "[FATAL ERROR] Exception caught in micro benchmarks: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -3,21 +3,24 @@
 // File:        Particle.h
 // Author:      Foster Rae
 // Date Created:2025-04-23
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.3
 // Description: Defines the ParticleType enumeration used to identify different
 //              element types throughout the simulation.
 // ============================================================================
 
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+
 // **=== Enums ===**
 
 /**
  * @brief Enumeration defining all possible types of elements (particles)
  * in the simulation grid.
  */
-enum class ParticleType {
+enum class ParticleType : std::uint8_t {
     EMPTY,
     SAND,
     SANDWET,
@@ -31,4 +34,12 @@ enum class ParticleType {
     // 
     // TODO:
     // maybe a NONE type for functions like getGasForm if sublimation isn't standard
-};
\ No newline at end of file
+};
+
+// **=== Constants ===**
+
+/**
+ * @brief Number of entries in ParticleType. Used to size per-type tables.
+ * Keep in sync with the last enum value above.
+ */
+inline constexpr std::size_t PARTICLE_TYPE_COUNT = static_cast<std::size_t>(ParticleType::STEAM) + 1;
\ No newline at end of file
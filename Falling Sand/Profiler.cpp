@@ -0,0 +1,96 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Profiler.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Implementation file for the Profiler class.
+// ============================================================================
+
+#include "Profiler.h"
+#include <algorithm>
+#include <cstdio>
+
+// **=== Constructors ===**
+
+Profiler::Profiler() {
+    for (PhaseWindow& window : m_windows) {
+        window.samples.reserve(WINDOW_SIZE);
+    }
+    m_sortScratch.reserve(WINDOW_SIZE);
+}
+
+// **=== Public Methods ===**
+
+void Profiler::record(ProfilePhase phase, double milliseconds) {
+    PhaseWindow& window = m_windows[static_cast<std::size_t>(phase)];
+    if (window.samples.size() < WINDOW_SIZE) {
+        window.samples.push_back(milliseconds);
+    }
+    else {
+        window.samples[window.next] = milliseconds; // Overwrite the oldest sample
+    }
+    window.next = (window.next + 1) % WINDOW_SIZE;
+}
+
+PhaseStats Profiler::getStats(ProfilePhase phase) const {
+    const PhaseWindow& window = m_windows[static_cast<std::size_t>(phase)];
+    PhaseStats stats;
+    stats.samples = window.samples.size();
+    if (window.samples.empty()) {
+        return stats;
+    }
+
+    m_sortScratch.assign(window.samples.begin(), window.samples.end());
+    std::sort(m_sortScratch.begin(), m_sortScratch.end());
+    auto percentile = [this](double p) { // Nearest-rank percentile
+        const std::size_t count = m_sortScratch.size();
+        std::size_t rank = static_cast<std::size_t>(p * count + 0.999999);
+        return m_sortScratch[std::clamp<std::size_t>(rank, 1, count) - 1];
+    };
+    stats.p50 = percentile(0.50);
+    stats.p95 = percentile(0.95);
+    stats.p99 = percentile(0.99);
+    return stats;
+}
+
+void Profiler::reset() {
+    for (PhaseWindow& window : m_windows) {
+        window.samples.clear();
+        window.next = 0;
+    }
+}
+
+std::string Profiler::formatReport() const {
+    std::string report = "PHASE (ms)       p50    p95    p99\n";
+    char line[96];
+    for (std::size_t i = 0; i < m_windows.size(); ++i) {
+        const ProfilePhase phase = static_cast<ProfilePhase>(i);
+        const PhaseStats stats = getStats(phase);
+        if (stats.samples == 0) {
+            continue;
+        }
+        std::snprintf(line, sizeof(line), "%-15s %6.2f %6.2f %6.2f\n", getPhaseName(phase), stats.p50, stats.p95, stats.p99);
+        report += line;
+    }
+    return report;
+}
+
+const char* Profiler::getPhaseName(ProfilePhase phase) {
+    switch (phase) {
+    case ProfilePhase::WorldUpdate:     return "World Update";
+    case ProfilePhase::Placements:      return " Placements";
+    case ProfilePhase::Wakes:           return " Wakes";
+    case ProfilePhase::TickSetup:       return " Tick Setup";
+    case ProfilePhase::Sweep:           return " Sweep";
+    case ProfilePhase::Cleanup:         return " Cleanup";
+    case ProfilePhase::SurfaceHeights:  return " Surface";
+    case ProfilePhase::Snapshot:        return "Snapshot";
+    case ProfilePhase::Events:          return "Events";
+    case ProfilePhase::PrepareFrame:    return "Prepare Frame";
+    case ProfilePhase::Render:          return "Render";
+    case ProfilePhase::Frame:           return "Frame";
+    default:                            return "Unknown";
+    }
+}
\ No newline at end of file
@@ -0,0 +1,144 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Profiler.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Header file for the Profiler and ScopedTimer classes.
+//              Scoped timers record how long each phase of a tick/frame
+//              takes into a rolling window per phase, from which p50, p95
+//              and p99 are reported (e.g. in the Game's profiler overlay).
+// ============================================================================
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The timed phases of World::update() and of a Game frame.
+ */
+enum class ProfilePhase {
+    // -- World::update() --
+    WorldUpdate,     // The whole of World::update()
+    Placements,      // Processing placement requests
+    Wakes,           // Applying the tick's wake requests
+    TickSetup,       // Promoting chunk dirty rectangles, new claim epoch
+    Sweep,           // Updating every awake element
+    Cleanup,         // Freeing elements replaced during the sweep
+    SurfaceHeights,  // Rescanning emptied column tops (plus validation, when enabled)
+    // -- Simulation thread --
+    Snapshot,        // Painting and publishing a render snapshot
+    // -- Game frame --
+    Events,          // Window events and real-time input
+    PrepareFrame,    // Painting the grid's pixels and uploading its texture
+    Render,          // Clearing, drawing and displaying the window
+    Frame,           // The whole frame
+    Count
+};
+
+/**
+ * @brief Percentiles of a phase's recent samples, in milliseconds.
+ */
+struct PhaseStats {
+    double p50 = 0.0;
+    double p95 = 0.0;
+    double p99 = 0.0;
+    std::size_t samples = 0;
+};
+
+/**
+ * @brief Keeps the most recent duration samples of every ProfilePhase.
+ *
+ * Each phase has a fixed-size ring of samples (a rolling window), so the
+ * percentiles follow the current load rather than the whole session. Not
+ * thread-safe: phases are recorded from the thread that runs update()/the frame.
+ */
+class Profiler {
+public:
+    // **=== Constants ===**
+    /** @brief Samples kept per phase (~4 seconds at 60 FPS). */
+    static constexpr std::size_t WINDOW_SIZE = 240;
+
+    // **=== Constructors ===**
+    Profiler();
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Adds a sample to a phase, replacing its oldest once the window is full.
+     * @param phase The phase.
+     * @param milliseconds The measured duration.
+     */
+    void record(ProfilePhase phase, double milliseconds);
+
+    /**
+     * @brief Computes the percentiles of a phase's current window.
+     * @param phase The phase.
+     * @return PhaseStats The percentiles (all zero if the phase has no samples).
+     */
+    PhaseStats getStats(ProfilePhase phase) const;
+
+    /**
+     * @brief Drops every sample.
+     */
+    void reset();
+
+    /**
+     * @brief Formats one line per phase that has samples: name, p50, p95 and p99.
+     * @return std::string The report.
+     */
+    std::string formatReport() const;
+
+    /**
+     * @brief Gets the display name of a phase.
+     * @param phase The phase.
+     * @return const char* The name.
+     */
+    static const char* getPhaseName(ProfilePhase phase);
+
+private:
+    // **=== Private Types ===**
+    struct PhaseWindow {
+        std::vector<double> samples; // Ring buffer, WINDOW_SIZE entries once full
+        std::size_t next = 0;        // Slot the next sample overwrites
+    };
+
+    // **=== Private Members ===**
+    std::array<PhaseWindow, static_cast<std::size_t>(ProfilePhase::Count)> m_windows;
+    /** @brief Reused by getStats() for sorting, so reports do not allocate. */
+    mutable std::vector<double> m_sortScratch;
+};
+
+/**
+ * @brief Times its own lifetime and records it to a Profiler phase.
+ * Does nothing when the profiler is nullptr, so call sites need no checks.
+ */
+class ScopedTimer {
+public:
+    ScopedTimer(Profiler* profiler, ProfilePhase phase)
+        : m_profiler(profiler), m_phase(phase) {
+        if (m_profiler) {
+            m_start = Clock::now();
+        }
+    }
+
+    ~ScopedTimer() {
+        if (m_profiler) {
+            m_profiler->record(m_phase, std::chrono::duration<double, std::milli>(Clock::now() - m_start).count());
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    using Clock = std::chrono::steady_clock;
+    Profiler* m_profiler;
+    ProfilePhase m_phase;
+    Clock::time_point m_start;
+};
\ No newline at end of file
@@ -0,0 +1,110 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Random.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Header file for the Random class.
+//              A small, fast, seedable xorshift64* generator used instead of
+//              the global C rand(). The World owns one stream per chunk so a
+//              seed plus the user's inputs fully determine a run.
+// ============================================================================
+
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Seedable xorshift64* pseudo-random number generator.
+ *
+ * One 64-bit word of state, a handful of shifts and a multiply per number.
+ * Not thread-safe: each thread (or chunk) uses its own instance. Independent
+ * streams are derived from one seed with a stream number (see seed()).
+ */
+class Random {
+public:
+    // **=== Constructors ===**
+
+    /**
+     * @brief Creates a generator for a stream of a seed.
+     * @param seed The seed.
+     * @param stream The stream number; different streams of the same seed are independent.
+     */
+    explicit Random(std::uint64_t seed = 0, std::uint64_t stream = 0) { this->seed(seed, stream); }
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Restarts the generator at the start of a stream of a seed.
+     * The seed and stream are scrambled with SplitMix64, so nearby seeds and
+     * consecutive stream numbers still give unrelated sequences.
+     * @param seed The seed.
+     * @param stream The stream number.
+     */
+    void seed(std::uint64_t seed, std::uint64_t stream = 0) {
+        m_state = splitMix64(seed + (stream + 1) * GOLDEN_GAMMA);
+        if (m_state == 0) {
+            m_state = GOLDEN_GAMMA; // xorshift must never hold an all-zero state
+        }
+    }
+
+    /**
+     * @brief Gets the next 64 random bits.
+     * @return std::uint64_t The next number.
+     */
+    std::uint64_t next() {
+        m_state ^= m_state >> 12;
+        m_state ^= m_state << 25;
+        m_state ^= m_state >> 27;
+        return m_state * 0x2545F4914F6CDD1DULL;
+    }
+
+    /**
+     * @brief Gets a random integer in [0, bound).
+     * Uses a multiply-shift instead of a modulo, so it costs no division.
+     * @param bound Exclusive upper bound (must be > 0).
+     * @return int The number.
+     */
+    int nextInt(int bound) {
+        return static_cast<int>(((next() >> 32) * static_cast<std::uint64_t>(bound)) >> 32);
+    }
+
+    /**
+     * @brief Flips a fair coin.
+     * @return true or false with equal probability.
+     */
+    bool coinFlip() { return (next() >> 63) != 0; }
+
+    /**
+     * @brief Picks a random horizontal direction.
+     * @return int 1 or -1 with equal probability.
+     */
+    int nextDirection() { return coinFlip() ? 1 : -1; }
+
+    /**
+     * @brief Rolls a percentage chance.
+     * @param percent Chance of success, 0 to 100.
+     * @return true with a probability of percent / 100.
+     */
+    bool chance(int percent) { return nextInt(100) < percent; }
+
+private:
+    // **=== Private Members ===**
+    static constexpr std::uint64_t GOLDEN_GAMMA = 0x9E3779B97F4A7C15ULL;
+
+    std::uint64_t m_state = GOLDEN_GAMMA;
+
+    // **=== Private Methods ===**
+
+    /**
+     * @brief One step of SplitMix64, used to scramble seeds.
+     * @param x The value to scramble.
+     * @return std::uint64_t The scrambled value.
+     */
+    static std::uint64_t splitMix64(std::uint64_t x) {
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+};
\ No newline at end of file
@@ -3,22 +3,19 @@
 // File:        SandElement.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.6
 // Description: Implementation file for the SandElement class.
 // ============================================================================
 
 #include "SandElement.h"
 #include "World.h"
 #include "Particle.h"
-#include <SFML/Graphics.hpp>
 #include <memory>
 #include <cstdlib>
 
 // **=== Constructor ===**
-SandElement::SandElement() {
-    initializeColorVariation(getColor());
-}
+SandElement::SandElement() : DynamicSolid(ParticleType::SAND) {}
 
 // **=== Overridden Public Methods ===**
 
@@ -39,22 +36,15 @@ void SandElement::update(World& world, int r, int c) {
 
     // TODO: Add temperature-based logic (melting checks using getMeltingPoint)
     // TODO: Add interactions with other elements based on temperature/type
-
-    // Mark this element as updated for this tick AFTER its state is final
-    this->markAsUpdated();
-}
-
-sf::Color SandElement::getColor() const {
-    return sf::Color(194, 178, 128);
 }
 
-ParticleType SandElement::getType() const {
-    return ParticleType::SAND;
+Color SandElement::getColor() const {
+    return getTraits().baseColor;
 }
 
 float SandElement::getDensity() const {
     // Sand is denser than water (typically ~1.0), less dense than many rocks/metals
-    return 1.6f;
+    return getTraits().density;
 }
 
 
@@ -72,17 +62,17 @@ float SandElement::getThermalConductivity() const {
 
 float SandElement::getMeltingPoint() const {
     // Silica sand melts at a very high temperature
-    return 1700.0f;
+    return getTraits().meltingPoint;
 }
 
 ParticleType SandElement::getLiquidForm() const {
     // What does sand turn into when melted? Molten glass/silica.
     // Don't have this type yet. Return EMPTY for now.
     // TODO: Add ParticleType::MOLTEN_GLASS
-    return ParticleType::EMPTY;
+    return getTraits().liquidForm;
 }
 
 ParticleType SandElement::getGasForm() const {
     // Sand doesn't typically sublimate.
-    return ParticleType::EMPTY;
+    return getTraits().gasForm;
 }
\ No newline at end of file
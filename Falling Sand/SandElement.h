@@ -3,8 +3,8 @@
 // File:        SandElement.h
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.6
 // Description: Header file for the SandElement class. Represents sand particles.
 //              Inherits from DynamicSolid.
 // ============================================================================
@@ -27,7 +27,10 @@ class SandElement : public DynamicSolid {
 public:
     // **=== Constructors / Destructor ===**
 
-    /** @brief Default constructor. */
+    /**
+     * @brief Constructs a sand element.
+     * (Its color variant is seeded by World::createElementByType(), see Element::seedColorVariant().)
+     */
     SandElement();
     /** @brief Default virtual destructor. */
     virtual ~SandElement() = default;
@@ -44,15 +47,9 @@ public:
 
     /**
      * @brief Gets the display color for Sand.
-     * @return sf::Color The color of sand.
-     */
-    sf::Color getColor() const override;
-
-    /**
-     * @brief Gets the type identifier for Sand.
-     * @return ParticleType The ParticleType::SAND enum value.
+     * @return Color The color of sand.
      */
-    ParticleType getType() const override;
+    Color getColor() const override;
 
     /**
      * @brief Gets the density of Sand.
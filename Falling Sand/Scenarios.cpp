@@ -0,0 +1,153 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Scenarios.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.3
+// Description: Implementation file for the Scenarios namespace.
+// ============================================================================
+
+#include "Scenarios.h"
+#include "World.h"
+#include "CompactWorld.h"
+#include "Particle.h"
+#include "Random.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+// **=== Layout Helpers ===**
+
+/**
+ * @brief Fills the half-open rectangle [rowBegin, rowEnd) x [colBegin, colEnd) with one type, clipped to the world.
+ */
+template <typename WorldType>
+static void fillRect(WorldType& world, int rowBegin, int colBegin, int rowEnd, int colEnd, ParticleType type) {
+    rowBegin = std::max(rowBegin, 0);
+    colBegin = std::max(colBegin, 0);
+    rowEnd = std::min(rowEnd, world.getRows());
+    colEnd = std::min(colEnd, world.getCols());
+    for (int r = rowBegin; r < rowEnd; ++r) {
+        for (int c = colBegin; c < colEnd; ++c) {
+            world.setElementByType(r, c, type);
+        }
+    }
+}
+
+/**
+ * @brief Lays a dirt floor over the bottom sixth of the world.
+ * @return int The first row of the floor.
+ */
+template <typename WorldType>
+static int fillFloor(WorldType& world) {
+    const int floorTop = world.getRows() - world.getRows() / 6;
+    fillRect(world, floorTop, 0, world.getRows(), world.getCols(), ParticleType::DIRT);
+    return floorTop;
+}
+
+// **=== Scenario Layouts ===**
+
+/**
+ * @brief Fills either engine's world with a scenario; both have the same placement interface.
+ */
+template <typename WorldType>
+static void applyScenario(WorldType& world, const std::string& name) {
+    const int rows = world.getRows();
+    const int cols = world.getCols();
+
+    if (name == "empty") {
+        return; // Nothing to place
+    }
+    else if (name == "sandpile") {
+        // A block of sand above a dirt floor that collapses into a pile
+        fillFloor(world);
+        fillRect(world, 0, cols / 3, rows / 3, cols - cols / 3, ParticleType::SAND);
+    }
+    else if (name == "dambreak") {
+        // A tall column of water released over a dirt floor
+        const int floorTop = fillFloor(world);
+        fillRect(world, rows / 4, 0, floorTop, cols / 3, ParticleType::WATER);
+    }
+    else if (name == "mixed") {
+        // Sand falling beside a block of water, both onto a dirt floor
+        fillFloor(world);
+        fillRect(world, 0, cols / 16, rows / 4, cols / 4, ParticleType::SAND);
+        fillRect(world, 0, cols / 2, rows / 4, cols - cols / 5, ParticleType::WATER);
+    }
+    else if (name == "noise") {
+        // Top half scattered with sand and water; reproducible from the world's seed
+        Random rng(world.getSeed(), UINT64_MAX - 1); // A stream no chunk or brush uses
+        for (int r = 0; r < rows / 2; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                const int roll = rng.nextInt(100);
+                if (roll < 30) {
+                    world.setElementByType(r, c, ParticleType::SAND);
+                }
+                else if (roll < 60) {
+                    world.setElementByType(r, c, ParticleType::WATER);
+                }
+            }
+        }
+    }
+    else if (name == "slosh") {
+        // A deep tank of water, heaped up against the left wall so it sloshes across
+        fillRect(world, rows / 2, 0, rows, cols, ParticleType::WATER);
+        fillRect(world, rows / 6, 0, rows / 2, cols / 2, ParticleType::WATER);
+    }
+    else if (name == "grassfield") {
+        // Bare dirt hills that grow grass and settle; mostly static after the first seconds
+        const int floorTop = fillFloor(world);
+        for (int c = 0; c < cols; ++c) {
+            const int hill = (c / std::max(cols / 8, 1)) % 2 == 0 ? rows / 12 : rows / 24;
+            fillRect(world, floorTop - hill, c, floorTop, c + 1, ParticleType::DIRT);
+        }
+    }
+    else if (name == "sandwater") {
+        // A layer of sand dropping into a pool of water
+        const int floorTop = fillFloor(world);
+        fillRect(world, floorTop - rows / 4, 0, floorTop, cols, ParticleType::WATER);
+        fillRect(world, 0, cols / 4, rows / 6, cols - cols / 4, ParticleType::SAND);
+    }
+    else if (name == "meadow") {
+        // Sand falling into a pond on a grass field: sand, water, dirt and grass all busy at once
+        const int floorTop = fillFloor(world);
+        fillRect(world, floorTop - 1, 0, floorTop, cols, ParticleType::GRASS);
+        fillRect(world, floorTop - 1 - rows / 6, cols / 3, floorTop - 1, cols - cols / 3, ParticleType::WATER);
+        fillRect(world, 0, cols / 4, rows / 8, cols - cols / 4, ParticleType::SAND);
+    }
+    else if (name == "static") {
+        // Every cell full of buried dirt; all chunks fall asleep after a few ticks
+        fillRect(world, 0, 0, rows, cols, ParticleType::DIRT);
+    }
+    else if (name == "allawake") {
+        // Worst case: the whole world a random mix of sand and water, sand sinking through water everywhere
+        Random rng(world.getSeed(), UINT64_MAX - 1); // A stream no chunk or brush uses
+        for (int r = 0; r < rows; ++r) {
+            for (int c = 0; c < cols; ++c) {
+                world.setElementByType(r, c, rng.coinFlip() ? ParticleType::SAND : ParticleType::WATER);
+            }
+        }
+    }
+    else {
+        throw std::invalid_argument("Unknown scenario: " + name);
+    }
+}
+
+// **=== Public Functions ===**
+
+const std::vector<std::string>& Scenarios::getNames() {
+    static const std::vector<std::string> names = {
+        "empty", "sandpile", "dambreak", "mixed", "noise",
+        "slosh", "grassfield", "sandwater", "meadow", "static", "allawake"
+    };
+    return names;
+}
+
+void Scenarios::apply(World& world, const std::string& name) {
+    applyScenario(world, name);
+}
+
+void Scenarios::apply(CompactWorld& world, const std::string& name) {
+    applyScenario(world, name);
+}
\ No newline at end of file
@@ -0,0 +1,54 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Scenarios.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.2
+// Description: Header file for the Scenarios namespace.
+//              Named initial world layouts (sand piles, dam breaks, ...)
+//              used to start headless runs and benchmarks from a known
+//              state. Layouts scale with the world's dimensions.
+// ============================================================================
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+class World;
+class CompactWorld;
+
+/**
+ * @brief Namespace containing the named starting layouts for a World.
+ */
+namespace Scenarios {
+
+    // **=== Public Functions ===**
+
+    /**
+     * @brief Gets the names of every scenario, in the order they are listed in help text.
+     * @return const std::vector<std::string>& The scenario names.
+     */
+    const std::vector<std::string>& getNames();
+
+    /**
+     * @brief Fills a world with a named scenario's initial elements.
+     * Elements are placed directly (setElementByType), so they exist before the
+     * first update. Randomised layouts draw from the world's seed.
+     * @param world The world to fill. Expected to be empty.
+     * @param name The scenario name (see getNames()).
+     * @throws std::invalid_argument if the name is not a known scenario.
+     */
+    void apply(World& world, const std::string& name);
+
+    /**
+     * @brief Fills a CompactWorld with a named scenario's initial elements.
+     * Same layouts as the World overload, so the two engines can be compared.
+     * @param world The world to fill. Expected to be empty.
+     * @param name The scenario name (see getNames()).
+     * @throws std::invalid_argument if the name is not a known scenario.
+     */
+    void apply(CompactWorld& world, const std::string& name);
+
+}
\ No newline at end of file
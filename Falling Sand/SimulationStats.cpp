@@ -0,0 +1,71 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        SimulationStats.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Implementation file for the simulation event counters.
+// ============================================================================
+
+#include "SimulationStats.h"
+#include "Utils.h"
+#include <cstdio>
+
+// **=== Public Methods ===**
+
+void SimulationStats::add(const SimulationStats& other) {
+    for (std::size_t t = 0; t < PARTICLE_TYPE_COUNT; ++t) {
+        TypeEventCounts& counts = types[t];
+        const TypeEventCounts& added = other.types[t];
+        counts.updates += added.updates;
+        counts.moveAttempts += added.moveAttempts;
+        counts.moves += added.moves;
+        counts.swaps += added.swaps;
+        counts.displaced += added.displaced;
+        for (std::size_t reason = 0; reason < MOVE_FAILURE_COUNT; ++reason) {
+            counts.failures[reason] += added.failures[reason];
+        }
+        counts.wakes += added.wakes;
+        counts.sleeps += added.sleeps;
+
+        for (std::size_t to = 0; to < PARTICLE_TYPE_COUNT; ++to) {
+            transitions[t][to] += other.transitions[t][to];
+        }
+    }
+}
+
+std::string SimulationStats::formatReport() const {
+    std::string report = "TYPE      UPD   TRY  MOVE  SWAP  DISP   OOB CLAIM  BLCK  WAKE SLEEP\n";
+    char line[128];
+    for (std::size_t t = 0; t < PARTICLE_TYPE_COUNT; ++t) {
+        const TypeEventCounts& counts = types[t];
+        if (counts.updates == 0 && counts.moveAttempts == 0 && counts.displaced == 0 && counts.wakes == 0) {
+            continue;
+        }
+        std::snprintf(line, sizeof(line), "%-7.7s %5llu %5llu %5llu %5llu %5llu %5llu %5llu %5llu %5llu %5llu\n",
+            Utils::getNameForType(static_cast<ParticleType>(t)).c_str(),
+            static_cast<unsigned long long>(counts.updates),
+            static_cast<unsigned long long>(counts.moveAttempts),
+            static_cast<unsigned long long>(counts.moves),
+            static_cast<unsigned long long>(counts.swaps),
+            static_cast<unsigned long long>(counts.displaced),
+            static_cast<unsigned long long>(counts.getFailures(MoveFailure::OutOfBounds)),
+            static_cast<unsigned long long>(counts.getFailures(MoveFailure::Claimed)),
+            static_cast<unsigned long long>(counts.getFailures(MoveFailure::Blocked)),
+            static_cast<unsigned long long>(counts.wakes),
+            static_cast<unsigned long long>(counts.sleeps));
+        report += line;
+    }
+
+    for (std::size_t from = 0; from < PARTICLE_TYPE_COUNT; ++from) {
+        for (std::size_t to = 0; to < PARTICLE_TYPE_COUNT; ++to) {
+            if (transitions[from][to] == 0) {
+                continue;
+            }
+            report += Utils::getNameForType(static_cast<ParticleType>(from)) + " -> " +
+                Utils::getNameForType(static_cast<ParticleType>(to)) + ": " + std::to_string(transitions[from][to]) + "\n";
+        }
+    }
+    return report;
+}
\ No newline at end of file
@@ -0,0 +1,102 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        SimulationStats.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Header file for the simulation event counters. The World
+//              counts updates, moves, swaps, failed moves, wakes, sleeps and
+//              type transitions per ParticleType, so the cost of a tick can
+//              be traced back to what the elements were doing.
+// ============================================================================
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "Particle.h"
+
+// **=== Enums ===**
+
+/**
+ * @brief Why World::tryMoveOrSwap() refused a move.
+ */
+enum class MoveFailure {
+    OutOfBounds, // Target outside the grid
+    Claimed,     // Target already received an element this tick
+    Blocked,     // Target holds a solid or an equally dense or denser fluid
+    Count
+};
+
+inline constexpr std::size_t MOVE_FAILURE_COUNT = static_cast<std::size_t>(MoveFailure::Count);
+
+// **=== Structs ===**
+
+/**
+ * @brief Event counts of the elements of one ParticleType.
+ */
+struct TypeEventCounts {
+    std::uint64_t updates = 0;      // Element::update() calls
+    std::uint64_t moveAttempts = 0; // tryMoveOrSwap() calls with an element of this type as the mover
+    std::uint64_t moves = 0;        // Successful moves into an empty cell
+    std::uint64_t swaps = 0;        // Successful swaps with a lighter fluid
+    std::uint64_t displaced = 0;    // Times an element of this type was the fluid swapped out of the way
+    std::array<std::uint64_t, MOVE_FAILURE_COUNT> failures{}; // Failed attempts by reason
+    std::uint64_t wakes = 0;        // Wake requests issued by moves, swaps and placements
+    std::uint64_t sleeps = 0;       // Updates after which the element fell asleep
+
+    /**
+     * @brief Gets the number of failed move attempts for one reason.
+     * @param reason The failure reason.
+     * @return std::uint64_t The count.
+     */
+    std::uint64_t getFailures(MoveFailure reason) const { return failures[static_cast<std::size_t>(reason)]; }
+};
+
+/**
+ * @brief Every event counter of the World, for one tick or accumulated over many.
+ */
+struct SimulationStats {
+    /** @brief Counts per ParticleType (indexed by the type's value). */
+    std::array<TypeEventCounts, PARTICLE_TYPE_COUNT> types{};
+    /** @brief Element replacements, indexed [from type][to type] (e.g. DIRT -> GRASS). */
+    std::array<std::array<std::uint64_t, PARTICLE_TYPE_COUNT>, PARTICLE_TYPE_COUNT> transitions{};
+
+    /**
+     * @brief Gets the counts of one type.
+     * @param type The ParticleType.
+     * @return TypeEventCounts& The counts.
+     */
+    TypeEventCounts& of(ParticleType type) { return types[static_cast<std::size_t>(type)]; }
+    const TypeEventCounts& of(ParticleType type) const { return types[static_cast<std::size_t>(type)]; }
+
+    /**
+     * @brief Gets the number of times an element of one type was replaced by another.
+     * @param from The replaced element's type.
+     * @param to The new element's type (EMPTY if the cell was cleared).
+     * @return std::uint64_t The count.
+     */
+    std::uint64_t getTransitions(ParticleType from, ParticleType to) const {
+        return transitions[static_cast<std::size_t>(from)][static_cast<std::size_t>(to)];
+    }
+
+    /**
+     * @brief Adds every counter of another set of stats to this one.
+     * @param other The stats to add.
+     */
+    void add(const SimulationStats& other);
+
+    /**
+     * @brief Sets every counter to zero.
+     */
+    void clear() { *this = SimulationStats(); }
+
+    /**
+     * @brief Formats one line per type that had any events, then every non-zero transition.
+     * @return std::string The report.
+     */
+    std::string formatReport() const;
+};
\ No newline at end of file
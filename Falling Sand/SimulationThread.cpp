@@ -0,0 +1,205 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        SimulationThread.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Implementation file for the SimulationThread class.
+// ============================================================================
+
+#include "SimulationThread.h"
+#include "JobSystem.h"
+#include "Trace.h"
+#include <utility>
+
+// **=== Constructors & Destructors ===**
+
+SimulationThread::SimulationThread(World& world, JobSystem& jobs, double tickRate)
+    : m_world(world), m_jobs(jobs), m_tickRate(tickRate) {}
+
+SimulationThread::~SimulationThread() {
+    stop();
+}
+
+// **=== Public Methods ===**
+
+void SimulationThread::start() {
+    if (isRunning()) {
+        return;
+    }
+    m_world.setProfiler(&m_profiler);
+    m_rateWindowStart = std::chrono::steady_clock::now();
+    m_ticksInWindow = 0;
+    publish(); // The render thread has a picture from its first frame on
+    m_stopRequested.store(false, std::memory_order_relaxed);
+    m_thread = std::thread(&SimulationThread::run, this);
+}
+
+void SimulationThread::stop() {
+    if (!isRunning()) {
+        return;
+    }
+    m_stopRequested.store(true, std::memory_order_relaxed);
+    m_thread.join();
+    m_world.setProfiler(nullptr);
+}
+
+void SimulationThread::requestPlacements(const std::vector<PlacementRequest>& requests) {
+    std::lock_guard<std::mutex> lock(m_inputMutex);
+    m_placementQueue.insert(m_placementQueue.end(), requests.begin(), requests.end());
+}
+
+void SimulationThread::post(std::function<void(World&)> command) {
+    std::lock_guard<std::mutex> lock(m_inputMutex);
+    m_commandQueue.push_back(std::move(command));
+}
+
+// **=== Private Methods ===**
+
+void SimulationThread::run() {
+    FS_TRACE_THREAD_NAME("Simulation");
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point nextTick = Clock::now();
+
+    while (!m_stopRequested.load(std::memory_order_relaxed)) {
+        const double tickRate = getTickRate();
+
+        // -- Unthrottled: tick and publish back to back --
+        if (tickRate <= 0.0) {
+            drainInput();
+            tick();
+            publish();
+            nextTick = Clock::now();
+            continue;
+        }
+
+        // -- Fixed timestep: wait for the next tick's slot --
+        const Clock::duration step = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / tickRate));
+        Clock::time_point now = Clock::now();
+        if (now < nextTick) {
+            std::this_thread::sleep_until(nextTick);
+            continue;
+        }
+
+        // Run every tick that is due, up to the catch-up limit
+        for (int ticks = 0; ticks < MAX_CATCH_UP_TICKS && now >= nextTick; ++ticks) {
+            drainInput();
+            tick();
+            nextTick += step;
+            now = Clock::now();
+        }
+        if (now >= nextTick) {
+            nextTick = now; // Still behind: drop the backlog rather than spiral
+        }
+        publish();
+    }
+}
+
+void SimulationThread::drainInput() {
+    {
+        std::lock_guard<std::mutex> lock(m_inputMutex);
+        m_placementsToApply.swap(m_placementQueue);
+        m_commandsToRun.swap(m_commandQueue);
+    }
+    for (const std::function<void(World&)>& command : m_commandsToRun) {
+        command(m_world);
+    }
+    for (const PlacementRequest& request : m_placementsToApply) {
+        m_world.requestPlacement(request.r, request.c, request.type);
+    }
+    m_commandsToRun.clear();
+    m_placementsToApply.clear();
+}
+
+void SimulationThread::tick() {
+    m_world.update();
+    ++m_tick;
+
+    // Measured rate, over windows of half a second
+    ++m_ticksInWindow;
+    const auto now = std::chrono::steady_clock::now();
+    const double elapsed = std::chrono::duration<double>(now - m_rateWindowStart).count();
+    if (elapsed >= 0.5) {
+        m_measuredTickRate = static_cast<double>(m_ticksInWindow) / elapsed;
+        m_ticksInWindow = 0;
+        m_rateWindowStart = now;
+    }
+}
+
+void SimulationThread::publish() {
+    ScopedTimer timer(&m_profiler, ProfilePhase::Snapshot);
+    FS_TRACE_SCOPE("Publish Snapshot");
+
+    // -- Every slot owes the areas that changed since the last publish --
+    m_world.takeChangedAreas(m_newAreas);
+    for (std::size_t slot = 0; slot < m_slotPendingAreas.size(); ++slot) {
+        std::vector<DirtyRect>& pending = m_slotPendingAreas[slot];
+        if (m_slotNeedsFullPaint[slot]) {
+            continue;
+        }
+        if (pending.size() + m_newAreas.size() > MAX_PENDING_AREAS) {
+            m_slotNeedsFullPaint[slot] = true; // Held by a stalled reader; repaint it all when it comes back
+            pending.clear();
+            continue;
+        }
+        pending.insert(pending.end(), m_newAreas.begin(), m_newAreas.end());
+    }
+
+    // -- Bring the back slot's pixels up to date --
+    const int back = m_snapshots.getBackIndex();
+    RenderSnapshot& snapshot = m_snapshots.getBack();
+    if (m_slotNeedsFullPaint[back] || snapshot.plane.getRows() != m_world.getRows() || snapshot.plane.getCols() != m_world.getCols()) {
+        snapshot.plane.fill(m_world, m_jobs);
+    }
+    else {
+        for (const DirtyRect& area : m_slotPendingAreas[back]) {
+            snapshot.plane.fillArea(m_world, area); // Serially: areas from different publishes may overlap
+        }
+    }
+    m_slotPendingAreas[back].clear();
+    m_slotNeedsFullPaint[back] = false;
+
+    // -- What the reader must redraw: everything since the last snapshot it acquired --
+    // If the previous snapshot is still unread it may never be read, so its areas carry over
+    // (if the reader takes it meanwhile, it only redraws a little more than needed)
+    if (m_snapshots.isPublishedUnread()) {
+        snapshot.changedAreas = m_lastPublishedAreas;
+        snapshot.fullRepaint = m_lastPublishedFull;
+    }
+    else {
+        snapshot.changedAreas.clear();
+        snapshot.fullRepaint = false;
+    }
+    if (snapshot.changedAreas.size() + m_newAreas.size() > MAX_PENDING_AREAS) {
+        snapshot.fullRepaint = true;
+    }
+    if (snapshot.fullRepaint) {
+        snapshot.changedAreas.clear();
+    }
+    else {
+        snapshot.changedAreas.insert(snapshot.changedAreas.end(), m_newAreas.begin(), m_newAreas.end());
+    }
+    m_lastPublishedAreas = snapshot.changedAreas;
+    m_lastPublishedFull = snapshot.fullRepaint;
+
+    // -- Figures for the UI --
+    snapshot.tick = m_tick;
+    snapshot.ticksPerSecond = m_measuredTickRate;
+    snapshot.activeChunks = m_world.getActiveChunkCount();
+    snapshot.chunkCount = m_world.getChunkCount();
+    snapshot.awakeCells = m_world.getAwakeCellCount();
+    snapshot.threadCount = m_world.getThreadCount();
+    snapshot.batchingByType = m_world.isBatchingByType();
+    snapshot.pools = m_world.getTotalPoolStats();
+    if (m_reportsEnabled.load(std::memory_order_relaxed)) {
+        snapshot.profilerReport = m_profiler.formatReport();
+        snapshot.statsReport = m_world.getLastTickStats().formatReport();
+    }
+    else {
+        snapshot.profilerReport.clear();
+        snapshot.statsReport.clear();
+    }
+
+    m_snapshots.publish();
+}
\ No newline at end of file
@@ -0,0 +1,222 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        SimulationThread.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Header file for the SimulationThread class and the
+//              RenderSnapshot it publishes. Runs World::update() on its own
+//              thread at a fixed tick rate, independent of the display.
+// ============================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ColorPlane.h"
+#include "ElementPool.h"
+#include "Profiler.h"
+#include "TripleBuffer.h"
+#include "World.h"
+#include "WorldChunk.h"
+
+class JobSystem;
+
+/**
+ * @brief What the render thread needs of one simulation state: the grid's pixels
+ * and the figures the UI shows. Never changed while the render thread holds it.
+ */
+struct RenderSnapshot {
+    /** @brief The grid's colors after tick. */
+    ColorPlane plane;
+    /** @brief Areas of the plane that changed since the last snapshot the reader acquired. */
+    std::vector<DirtyRect> changedAreas;
+    /** @brief True if changedAreas is incomplete and the whole plane must be redrawn. */
+    bool fullRepaint = true;
+
+    // -- Simulation Info --
+    std::uint64_t tick = 0;
+    double ticksPerSecond = 0.0;   // Measured over the last half second
+    int activeChunks = 0;
+    int chunkCount = 0;
+    int awakeCells = 0;
+    int threadCount = 1;
+    bool batchingByType = false;
+    ElementPoolStats pools;
+    /** @brief Phase timings and last tick's events; empty unless reports are enabled. */
+    std::string profilerReport;
+    std::string statsReport;
+};
+
+/**
+ * @brief Runs a World on a dedicated thread with a fixed timestep.
+ *
+ * Ticks are scheduled every 1 / tickRate seconds. When a tick overruns, the
+ * loop catches up with up to MAX_CATCH_UP_TICKS ticks in a row and then drops
+ * the rest of the backlog, so a slow world runs slower instead of falling
+ * ever further behind. After each round of ticks a RenderSnapshot is painted
+ * and published through a TripleBuffer: the render thread always finds the
+ * newest finished one without waiting, and the simulation never waits for
+ * the display.
+ *
+ * Each of the three snapshot slots remembers the areas that changed since it
+ * was last painted, so a snapshot is brought up to date by repainting those
+ * areas only. Input reaches the world through queues drained before each tick.
+ *
+ * While the thread runs, the World (and the JobSystem it updates with) belong
+ * to it: other threads talk to the world only through requestPlacements() and
+ * post().
+ */
+class SimulationThread {
+public:
+    // **=== Constants ===**
+    /** @brief Tick rate unless changed (the display rate the Game used to tick at). */
+    static constexpr double DEFAULT_TICK_RATE = 60.0;
+    /** @brief Ticks run back to back to catch up before the backlog is dropped. */
+    static constexpr int MAX_CATCH_UP_TICKS = 4;
+    /** @brief Areas a slot may owe before it is repainted in full instead. */
+    static constexpr std::size_t MAX_PENDING_AREAS = 4096;
+
+    // **=== Constructors & Destructors ===**
+
+    /**
+     * @brief Prepares to run a world. Nothing starts until start().
+     * @param world The world to update. Must outlive this object.
+     * @param jobs Job system for painting snapshots (and for the world, if it uses one).
+     * @param tickRate Ticks per second; 0 runs as fast as possible.
+     */
+    SimulationThread(World& world, JobSystem& jobs, double tickRate = DEFAULT_TICK_RATE);
+
+    /**
+     * @brief Stops the thread if it is running.
+     */
+    ~SimulationThread();
+
+    SimulationThread(const SimulationThread&) = delete;
+    SimulationThread& operator=(const SimulationThread&) = delete;
+
+    // **=== Public Methods ===**
+
+    /**
+     * @brief Publishes a first snapshot, then starts ticking on a new thread.
+     * Does nothing if already running.
+     */
+    void start();
+
+    /**
+     * @brief Finishes the current round of ticks and joins the thread.
+     * Queued input that has not been applied yet is kept for the next start().
+     */
+    void stop();
+
+    bool isRunning() const { return m_thread.joinable(); }
+
+    // -- Input (any thread) --
+    /**
+     * @brief Queues element placements for the next tick. Thread-safe.
+     * @param requests The placements (see World::requestPlacement()).
+     */
+    void requestPlacements(const std::vector<PlacementRequest>& requests);
+
+    /**
+     * @brief Queues a command to run on the simulation thread before the next tick,
+     * e.g. to change a World setting. Thread-safe.
+     * @param command Callable taking the World.
+     */
+    void post(std::function<void(World&)> command);
+
+    /**
+     * @brief Sets the tick rate. Thread-safe.
+     * @param ticksPerSecond Ticks per second; 0 runs as fast as possible.
+     */
+    void setTickRate(double ticksPerSecond) { m_tickRate.store(ticksPerSecond, std::memory_order_relaxed); }
+    double getTickRate() const { return m_tickRate.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Sets whether snapshots carry the profiler and tick event reports (formatting
+     * them costs a little every publish). Thread-safe.
+     * @param enabled True to fill RenderSnapshot::profilerReport and statsReport.
+     */
+    void setReportsEnabled(bool enabled) { m_reportsEnabled.store(enabled, std::memory_order_relaxed); }
+
+    // -- Output (render thread) --
+    /**
+     * @brief Picks up the newest published snapshot, if there is one newer than the current.
+     * Never blocks. Render thread only.
+     * @return true if getSnapshot() changed.
+     */
+    bool acquireSnapshot() { return m_snapshots.acquire(); }
+
+    /**
+     * @brief Gets the snapshot picked up by the last acquireSnapshot(). Render thread only.
+     * @return const RenderSnapshot& The snapshot (empty before the first start()).
+     */
+    const RenderSnapshot& getSnapshot() const { return m_snapshots.getFront(); }
+
+private:
+    // **=== Private Members ===**
+    World& m_world;
+    JobSystem& m_jobs;
+    std::thread m_thread;
+    std::atomic<bool> m_stopRequested{ false };
+    std::atomic<double> m_tickRate;
+    std::atomic<bool> m_reportsEnabled{ false };
+
+    // -- Input --
+    std::mutex m_inputMutex;
+    std::vector<PlacementRequest> m_placementQueue;
+    std::vector<std::function<void(World&)>> m_commandQueue;
+
+    // -- Simulation thread only --
+    /** @brief Input taken from the queues, applied outside the lock. */
+    std::vector<PlacementRequest> m_placementsToApply;
+    std::vector<std::function<void(World&)>> m_commandsToRun;
+    Profiler m_profiler;
+    std::uint64_t m_tick = 0;
+    std::uint64_t m_ticksInWindow = 0;
+    std::chrono::steady_clock::time_point m_rateWindowStart;
+    double m_measuredTickRate = 0.0;
+    /** @brief Areas taken from the world at this publish. */
+    std::vector<DirtyRect> m_newAreas;
+    /** @brief Areas each slot has missed since it was last painted. */
+    std::array<std::vector<DirtyRect>, 3> m_slotPendingAreas;
+    /** @brief Slots that must be repainted in full (never painted, or too far behind). */
+    std::array<bool, 3> m_slotNeedsFullPaint{ true, true, true };
+    /** @brief The last published snapshot's changedAreas and fullRepaint, carried over if it goes unread. */
+    std::vector<DirtyRect> m_lastPublishedAreas;
+    bool m_lastPublishedFull = true;
+
+    // -- Output --
+    TripleBuffer<RenderSnapshot> m_snapshots;
+
+    // **=== Private Methods ===**
+
+    /**
+     * @brief The thread's loop: drain input, tick on schedule, publish.
+     */
+    void run();
+
+    /**
+     * @brief Applies queued commands and placements to the world.
+     */
+    void drainInput();
+
+    /**
+     * @brief Runs one World::update() and counts it for the measured rate.
+     */
+    void tick();
+
+    /**
+     * @brief Brings the back snapshot up to date with the world and publishes it.
+     */
+    void publish();
+};
\ No newline at end of file
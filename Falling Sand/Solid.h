@@ -3,8 +3,8 @@
 // File:        Solid.h
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-26
-// Version:     1.6
+// Last Update: 2026-10-16
+// Version:     1.8
 // Description: Header file for the Solid abstract class.
 //              Inherits from Element and serves as a base for solid sub-types
 //              (DynamicSolid, StaticSolid). Defines interfaces common
@@ -28,7 +28,13 @@ class World;
  */
 class Solid : public Element {
 public:
-    // **=== Destructor ===**
+    // **=== Constructors & Destructor ===**
+
+    /**
+     * @brief Constructs a solid element.
+     * @param type The concrete element's ParticleType.
+     */
+    explicit Solid(ParticleType type) : Element(type) {}
 
     /**
      * @brief Virtual destructor.
@@ -49,15 +55,9 @@ public:
 
     /**
      * @brief Gets the display color of this solid element.
-     * @return sf::Color The color for rendering.
-     */
-    virtual sf::Color getColor() const = 0;
-
-    /**
-     * @brief Gets the specific type identifier for this solid element.
-     * @return ParticleType The enum value (e.g., ParticleType::SAND).
+     * @return Color The color for rendering.
      */
-    virtual ParticleType getType() const = 0;
+    virtual Color getColor() const = 0;
 
     /**
      * @brief Gets the density of this solid element.
@@ -3,8 +3,8 @@
 // File:        StaticSolid.h
 // Author:      Foster Rae
 // Date Created:2025-04-25
-// Last Update: 2025-04-26
-// Version:     1.3
+// Last Update: 2026-10-16
+// Version:     1.5
 // Description: Header file for the StaticSolid abstract class.
 //              Inherits from Solid and serves as a base for solid elements
 //              that are typically immovable unless specific conditions are met
@@ -28,7 +28,13 @@ class World;
  */
 class StaticSolid : public Solid {
 public:
-    // **=== Destructor ===**
+    // **=== Constructors & Destructor ===**
+
+    /**
+     * @brief Constructs a static solid element.
+     * @param type The concrete element's ParticleType.
+     */
+    explicit StaticSolid(ParticleType type) : Solid(type) {}
 
     /**
      * @brief Virtual destructor.
@@ -49,15 +55,9 @@ public:
 
     /**
      * @brief Gets the display color of this static solid element.
-     * @return sf::Color The color for rendering.
-     */
-    virtual sf::Color getColor() const = 0;
-
-    /**
-     * @brief Gets the specific type identifier for this static solid element.
-     * @return ParticleType The enum value (e.g., ParticleType::DIRT).
+     * @return Color The color for rendering.
      */
-    virtual ParticleType getType() const = 0;
+    virtual Color getColor() const = 0;
 
     /**
      * @brief Gets the density of this static solid element.
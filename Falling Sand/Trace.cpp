@@ -0,0 +1,191 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Trace.cpp
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.1
+// Description: Implementation file for the timeline tracing functions.
+// ============================================================================
+
+#include "Trace.h"
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+// **=== Thread Buffers ===**
+
+namespace {
+    struct TraceEvent {
+        const char* name;
+        std::int64_t startNs;
+        std::int64_t endNs;
+    };
+
+    /**
+     * @brief One thread's ring of events. Only its own thread writes it.
+     */
+    struct ThreadBuffer {
+        std::vector<TraceEvent> events;
+        /** @brief Events recorded so far; slot = written % EVENTS_PER_THREAD. */
+        std::atomic<std::uint64_t> written{ 0 };
+        int threadId = 0;
+        std::string threadName;
+        /** @brief Whether a running thread owns it; guarded by the registry's mutex. */
+        bool inUse = true;
+    };
+
+    /**
+     * @brief Every thread's buffer. Buffers live until the process exits, so
+     * events of threads that have already finished can still be written; a
+     * later thread of the same name takes its buffer over (see setThreadName()).
+     */
+    struct Registry {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+    };
+
+    Registry& getRegistry() {
+        static Registry registry;
+        return registry;
+    }
+
+    thread_local ThreadBuffer* tls_buffer = nullptr;
+
+    /**
+     * @brief Hands the calling thread's buffer back to the registry when the thread exits.
+     * Kept apart from tls_buffer so record() does not pay for a thread_local destructor.
+     */
+    struct ThreadBufferRelease {
+        ThreadBuffer* buffer = nullptr;
+
+        ~ThreadBufferRelease() {
+            if (buffer) {
+                std::lock_guard<std::mutex> lock(getRegistry().mutex);
+                buffer->inUse = false;
+            }
+        }
+    };
+    thread_local ThreadBufferRelease tls_release;
+
+    /**
+     * @brief Gives the calling thread a new buffer. The registry's mutex must be held.
+     */
+    ThreadBuffer& bindNewBuffer(Registry& registry) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->events.resize(Trace::EVENTS_PER_THREAD);
+        buffer->threadId = static_cast<int>(registry.buffers.size());
+        buffer->threadName = "Thread " + std::to_string(buffer->threadId);
+        tls_buffer = buffer.get();
+        tls_release.buffer = tls_buffer;
+        registry.buffers.push_back(std::move(buffer));
+        return *tls_buffer;
+    }
+
+    /**
+     * @brief Gets the calling thread's buffer, creating it on first use.
+     */
+    ThreadBuffer& getThreadBuffer() {
+        if (!tls_buffer) {
+            Registry& registry = getRegistry();
+            std::lock_guard<std::mutex> lock(registry.mutex);
+            bindNewBuffer(registry);
+        }
+        return *tls_buffer;
+    }
+
+    /**
+     * @brief Escapes the characters JSON does not allow inside a string.
+     */
+    std::string escapeJson(const char* text) {
+        std::string escaped;
+        for (; *text; ++text) {
+            if (*text == '"' || *text == '\\') {
+                escaped += '\\';
+            }
+            escaped += *text;
+        }
+        return escaped;
+    }
+}
+
+// **=== Public Functions ===**
+
+std::int64_t Trace::now() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+void Trace::record(const char* name, std::int64_t startNs, std::int64_t endNs) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    const std::uint64_t written = buffer.written.load(std::memory_order_relaxed);
+    buffer.events[written % EVENTS_PER_THREAD] = TraceEvent{ name, startNs, endNs };
+    buffer.written.store(written + 1, std::memory_order_release);
+}
+
+void Trace::setThreadName(const std::string& name) {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    if (!tls_buffer) {
+        // A restarted thread (e.g. the simulation thread after SimulationThread::stop()) carries on its predecessor's track
+        for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers) {
+            if (!buffer->inUse && buffer->threadName == name) {
+                buffer->inUse = true;
+                tls_buffer = buffer.get();
+                tls_release.buffer = tls_buffer;
+                return;
+            }
+        }
+        bindNewBuffer(registry);
+    }
+    tls_buffer->threadName = name;
+}
+
+std::size_t Trace::writeChromeTrace(const std::string& path) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Failed to open trace output: " + path);
+    }
+
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+
+    // Complete ("X") events, timestamps in microseconds
+    std::size_t eventCount = 0;
+    char line[256];
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers) {
+        std::snprintf(line, sizeof(line), "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+            buffer->threadId, escapeJson(buffer->threadName.c_str()).c_str());
+        out << (eventCount++ ? ",\n" : "") << line;
+
+        // Oldest first: once the ring has wrapped it starts at the next write slot
+        const std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const std::uint64_t first = written > EVENTS_PER_THREAD ? written - EVENTS_PER_THREAD : 0;
+        for (std::uint64_t i = first; i < written; ++i) {
+            const TraceEvent& event = buffer->events[i % EVENTS_PER_THREAD];
+            std::snprintf(line, sizeof(line), "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                escapeJson(event.name).c_str(), buffer->threadId, event.startNs / 1000.0, (event.endNs - event.startNs) / 1000.0);
+            out << ",\n" << line;
+            ++eventCount;
+        }
+    }
+    out << "\n]}\n";
+
+    if (!out) {
+        throw std::runtime_error("Failed to write trace output: " + path);
+    }
+    return eventCount - registry.buffers.size(); // Thread names are metadata, not events
+}
+
+void Trace::clear() {
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const std::unique_ptr<ThreadBuffer>& buffer : registry.buffers) {
+        buffer->written.store(0, std::memory_order_release);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,101 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        Trace.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.1
+// Description: Timeline tracing. FS_TRACE_SCOPE records when a scope begins
+//              and ends, and on which thread, into a per-thread ring buffer.
+//              Trace::writeChromeTrace() saves the buffers as Chrome trace
+//              JSON, which chrome://tracing and ui.perfetto.dev can open.
+//
+//              Tracing is compiled in unless FALLING_SAND_ENABLE_TRACE is 0,
+//              in which case every macro expands to nothing.
+// ============================================================================
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifndef FALLING_SAND_ENABLE_TRACE
+#define FALLING_SAND_ENABLE_TRACE 1
+#endif
+
+namespace Trace {
+    /** @brief Whether FS_TRACE_* macros record anything in this build. */
+    inline constexpr bool ENABLED = FALLING_SAND_ENABLE_TRACE != 0;
+
+    /** @brief Events kept per thread; older events are overwritten. */
+    inline constexpr std::size_t EVENTS_PER_THREAD = 16384;
+
+    /**
+     * @brief Gets the current trace time.
+     * @return std::int64_t Nanoseconds since the first call in this process.
+     */
+    std::int64_t now();
+
+    /**
+     * @brief Adds a finished scope to the calling thread's buffer.
+     * @param name Name shown on the timeline. Must outlive the trace (use a string literal).
+     * @param startNs Begin time from now().
+     * @param endNs End time from now().
+     */
+    void record(const char* name, std::int64_t startNs, std::int64_t endNs);
+
+    /**
+     * @brief Names the calling thread on the timeline (default "Thread N").
+     * If a thread of the same name has exited, the calling thread takes over its
+     * buffer and track instead of adding new ones, so threads that are stopped and
+     * restarted do not pile up buffers. Call it before the thread records anything.
+     * @param name The thread's name.
+     */
+    void setThreadName(const std::string& name);
+
+    /**
+     * @brief Writes every thread's buffered events as Chrome trace JSON.
+     * Call it while no traced work is running (e.g. between ticks), since
+     * the buffers are read without locking their threads out.
+     * @param path The file to write. Throws std::runtime_error if it cannot be opened.
+     * @return std::size_t The number of events written.
+     */
+    std::size_t writeChromeTrace(const std::string& path);
+
+    /**
+     * @brief Drops every buffered event. Same threading rule as writeChromeTrace().
+     */
+    void clear();
+
+    /**
+     * @brief Records its own lifetime as one trace event. Use FS_TRACE_SCOPE.
+     */
+    class Scope {
+    public:
+        explicit Scope(const char* name) : m_name(name), m_start(now()) {}
+        ~Scope() { record(m_name, m_start, now()); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* m_name;
+        std::int64_t m_start;
+    };
+}
+
+// **=== Instrumentation Macros ===**
+
+#define FS_TRACE_CONCAT_INNER(a, b) a##b
+#define FS_TRACE_CONCAT(a, b) FS_TRACE_CONCAT_INNER(a, b)
+
+#if FALLING_SAND_ENABLE_TRACE
+/** @brief Traces the rest of the enclosing scope under a string literal name. */
+#define FS_TRACE_SCOPE(name) ::Trace::Scope FS_TRACE_CONCAT(fsTraceScope_, __LINE__)(name)
+/** @brief Names the calling thread on the timeline. */
+#define FS_TRACE_THREAD_NAME(name) ::Trace::setThreadName(name)
+#else
+#define FS_TRACE_SCOPE(name) ((void)0)
+#define FS_TRACE_THREAD_NAME(name) ((void)0)
+#endif
\ No newline at end of file
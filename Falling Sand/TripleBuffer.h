@@ -0,0 +1,97 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        TripleBuffer.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.0
+// Description: Lock-free triple buffer: one thread writes values, another
+//              reads the newest one, and neither ever waits for the other.
+// ============================================================================
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+/**
+ * @brief Three slots handed between one writer and one reader.
+ *
+ * The writer fills its back slot and publishes it; the reader acquires the
+ * most recently published slot as its front. The third slot sits in the
+ * middle, swapped in and out with a single atomic exchange, so a slow reader
+ * never holds up the writer (unread values are simply replaced) and the
+ * writer never touches the slot being read.
+ *
+ * @tparam T The value type. Slots are reused, so a writer can update them
+ *         incrementally instead of rebuilding them.
+ */
+template <typename T>
+class TripleBuffer {
+public:
+    // **=== Constructors ===**
+    TripleBuffer() = default;
+
+    TripleBuffer(const TripleBuffer&) = delete;
+    TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+    // **=== Writer ===**
+
+    /**
+     * @brief Gets the writer's slot. Writer thread only.
+     * @return T& The slot to fill before publish().
+     */
+    T& getBack() { return m_slots[m_back]; }
+
+    /**
+     * @brief Gets which slot (0 to 2) the writer holds, for bookkeeping kept per slot.
+     * @return int The slot index.
+     */
+    int getBackIndex() const { return m_back; }
+
+    /**
+     * @brief Hands the back slot to the reader and takes the middle one back. Writer thread only.
+     */
+    void publish() {
+        m_back = m_middle.exchange(m_back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+
+    /**
+     * @brief Checks if the last published slot has not been acquired yet. Writer thread only.
+     * Once false it stays false until the next publish().
+     * @return true if the reader has not picked up the last publish.
+     */
+    bool isPublishedUnread() const { return (m_middle.load(std::memory_order_acquire) & FRESH_BIT) != 0; }
+
+    // **=== Reader ===**
+
+    /**
+     * @brief Takes the most recently published slot, if there is a new one. Reader thread only.
+     * @return true if the front slot changed.
+     */
+    bool acquire() {
+        if ((m_middle.load(std::memory_order_relaxed) & FRESH_BIT) == 0) {
+            return false;
+        }
+        m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX_MASK;
+        return true;
+    }
+
+    /**
+     * @brief Gets the reader's slot: the last one acquired. Reader thread only.
+     * @return const T& The slot.
+     */
+    const T& getFront() const { return m_slots[m_front]; }
+
+private:
+    // **=== Private Constants ===**
+    static constexpr int INDEX_MASK = 0x3;
+    /** @brief Set in m_middle while its slot was published but not yet acquired. */
+    static constexpr int FRESH_BIT = 0x4;
+
+    // **=== Private Members ===**
+    std::array<T, 3> m_slots{};
+    int m_back = 0;
+    int m_front = 1;
+    std::atomic<int> m_middle{ 2 };
+};
\ No newline at end of file
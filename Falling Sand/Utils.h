@@ -3,8 +3,8 @@
 // File:        Utils.h
 // Author:      Foster Rae
 // Date Created:2025-04-23
-// Last Update: 2025-04-26
-// Version:     1.1
+// Last Update: 2026-10-16
+// Version:     1.2
 // Description: Header file for general utility functions, particularly
 //              those related to particles (Elements) but not tied to
 //              World or Game state directly.
@@ -12,8 +12,8 @@
 
 #pragma once
 
-#include <SFML/Graphics.hpp>
 #include <string>
+#include "Color.h"
 #include "Particle.h"
 
 /**
@@ -26,9 +26,9 @@ namespace Utils {
     /**
      * @brief Gets the display color for a given particle type.
      * @param type The ParticleType enum value.
-     * @return sf::Color The color associated with the particle type.
+     * @return Color The color associated with the particle type.
      */
-    sf::Color getColorForType(ParticleType type);
+    Color getColorForType(ParticleType type);
 
     /**
      * @brief Converts a particle type enum to its string name (for UI or debugging).
@@ -3,25 +3,21 @@
 // File:        WaterElement.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-26
-// Last Update: 2025-04-27
-// Version:     1.4
+// Last Update: 2026-10-16
+// Version:     1.8
 // Description: Implementation file for the WaterElement class. (Single Base Color)
 // ============================================================================
 
 #include "WaterElement.h"
 #include "World.h"
 #include "Particle.h"
-#include <SFML/Graphics.hpp>
 #include <memory>
 #include <cstdlib>
 #include <algorithm>
 
 // **=== Constructor ===**
 
-WaterElement::WaterElement() {
-    // Directly set the single base color for all water particles.
-    m_variedColor = sf::Color(60, 120, 180);
-}
+WaterElement::WaterElement() : Liquid(ParticleType::WATER) {}
 
 
 // **=== Overridden Public Methods ===**
@@ -45,39 +41,32 @@ void WaterElement::update(World& world, int r, int c) {
         }
     }
 
-    // --- Update Mark ---
-    if (!acted && !attemptEvaporation(world, r, c)) {
+    // --- Sleep ---
+    if (!acted) {
         //this->potentiallyGoToSleep();
     }
-    if (!attemptEvaporation(world, r, c)) {
-        this->markAsUpdated();
-    }
 }
 
-sf::Color WaterElement::getColor() const {
+Color WaterElement::getColor() const {
     // This still returns the conceptual base color, which is consistent
     // with what we set in the constructor.
-    return sf::Color(60, 120, 180);
-}
-
-ParticleType WaterElement::getType() const {
-    return ParticleType::WATER;
+    return getTraits().baseColor;
 }
 
 // **=== Property Implementations ===**
 
 float WaterElement::getDensity() const {
-    return 1.0f;
+    return getTraits().density;
 }
 
 int WaterElement::getDispersionRate() const {
-    return 7;
+    return getTraits().dispersionRate;
 }
 
 float WaterElement::getBoilingPoint() const {
-    return 100.0f; // Degrees C
+    return getTraits().boilingPoint; // Degrees C
 }
 
 ParticleType WaterElement::getGasForm() const {
-    return ParticleType::STEAM;
+    return getTraits().gasForm;
 }
\ No newline at end of file
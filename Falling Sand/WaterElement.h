@@ -3,8 +3,8 @@
 // File:        WaterElement.h
 // Author:      Foster Rae
 // Date Created:2025-04-26
-// Last Update: 2025-04-26
-// Version:     1.2
+// Last Update: 2026-10-16
+// Version:     1.4
 // Description: Header file for the WaterElement class. Represents water.
 //              Inherits from Liquid.
 // ============================================================================
@@ -44,15 +44,9 @@ public:
 
     /**
      * @brief Gets the display color for Water.
-     * @return sf::Color The color of water.
+     * @return Color The color of water.
      */
-    sf::Color getColor() const override;
-
-    /**
-     * @brief Gets the type identifier for Water.
-     * @return ParticleType The ParticleType::WATER enum value.
-     */
-    ParticleType getType() const override;
+    Color getColor() const override;
 
     /**
      * @brief Gets the density of Water.
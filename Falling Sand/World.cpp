@@ -3,60 +3,99 @@
 // File:        World.cpp
 // Author:      Foster Rae
 // Date Created:2025-04-23
-// Last Update: 2025-04-26
-// Version:     1.5
+// Last Update: 2026-10-16
+// Version:     2.17
 // Description: Implementation file for the World class. Manages the grid
 //              of Elements and the simulation update cycle.
 // ============================================================================
 
 #include "World.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include "Trace.h"
 #include <vector>
 #include <memory>
 #include <stdexcept>
 #include <utility>
 #include <cstdlib>
+#include <algorithm>
+#include <string>
+#include <bit>
 
 // **=== Element Includes ===**
-#include "SandElement.h"
-#include "Liquid.h"
-#include "Gas.h"
-#include "DirtElement.h"
-#include "GrassElement.h"
-#include "WaterElement.h"
+#include "ElementRegistry.h"
 
 
 // **=== Constructors & Destructors ===**
 
-World::World(int numRows, int numCols) : m_rows(numRows), m_cols(numCols), m_sweepRight(true), m_surfaceHeights(numCols, numRows) {
+World::World(int numRows, int numCols, std::uint64_t seed) : m_rows(numRows), m_cols(numCols), m_stride(0), m_chunkRows(0), m_chunkCols(0), m_sweepRight(true) {
     // Validate dimensions
     if (m_rows <= 0 || m_cols <= 0) {
         throw std::invalid_argument("World dimensions (rows, cols) must be positive.");
     }
 
     // --- Grid Initialization ---
-    m_grid.resize(m_rows);
-    m_nextGrid.resize(m_rows);
-    for (int i = 0; i < m_rows; ++i) {
-        m_grid[i].resize(m_cols);
-        m_nextGrid[i].resize(m_cols);
+    // Pad each row out to a whole number of cache lines so rows never share a line,
+    // with room for the wake dilation to spill past the last column
+    constexpr int cellsPerLine = static_cast<int>(CACHE_LINE_SIZE / sizeof(ElementPtr));
+    m_stride = ((m_cols + MAX_WAKE_RADIUS + cellsPerLine - 1) / cellsPerLine) * cellsPerLine;
+    m_grid.resize(static_cast<size_t>(m_rows) * m_stride);
+    m_claimStamps.assign(m_grid.size(), 0);
+    m_awakeBits = std::vector<std::atomic<std::uint64_t>>((m_grid.size() + 63) / 64); // All asleep (value-initialised)
+    m_threadScratch.resize(1); // Single-threaded until setJobSystem()
+
+    // --- Wake Requests ---
+    for (std::vector<std::atomic<std::uint64_t>>& requests : m_wakeRequests) {
+        requests = std::vector<std::atomic<std::uint64_t>>(m_awakeBits.size());
     }
+    m_wakeRadius.fill(DEFAULT_WAKE_RADIUS);
+
+    // --- Chunk Initialization ---
+    m_chunkRows = (m_rows + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunkCols = (m_cols + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    m_chunks = std::vector<WorldChunk>(static_cast<size_t>(m_chunkRows) * m_chunkCols); // Atomics are not movable, so no resize()
+    setSeed(seed);
+
+    // --- Surface Heights ---
+    // Every column segment starts empty
+    m_segmentTops = std::vector<std::atomic<std::uint8_t>>(static_cast<size_t>(m_chunkRows) * m_cols);
+    for (std::atomic<std::uint8_t>& top : m_segmentTops) {
+        top.store(CHUNK_SIZE, std::memory_order_relaxed);
+    }
+#ifdef NDEBUG
+    m_validateSurfaceHeights = false;
+#else
+    m_validateSurfaceHeights = true;
+#endif
+
+    // --- Element Pools ---
+    // Created up front (slabs are still allocated lazily) so the parallel update never races to create one
+#define FS_CREATE_POOL(TYPE, CLASS) createPool<CLASS>(ParticleType::TYPE);
+    FS_FOR_EACH_ELEMENT_CLASS(FS_CREATE_POOL)
+#undef FS_CREATE_POOL
 }
 
 // **=== Public Getters ===**
 
 int World::getSurfaceHeight(int c) const {
     if (c >= 0 && c < m_cols) {
-        return m_surfaceHeights[c];
+        // The first non-empty segment from the top holds the surface
+        for (int cr = 0; cr < m_chunkRows; ++cr) {
+            const int top = m_segmentTops[static_cast<size_t>(cr) * m_cols + c].load(std::memory_order_relaxed);
+            if (top < CHUNK_SIZE) {
+                return cr * CHUNK_SIZE + top;
+            }
+        }
     }
-    // Out of bounds, return a value indicating empty/bottom
+    // Empty column or out of bounds, return a value indicating empty/bottom
     return m_rows;
 }
 int World::getRows() const { return m_rows; }
 int World::getCols() const { return m_cols; }
-const std::vector<std::vector<std::unique_ptr<Element>>>& World::getGridState() const { return m_grid; }
+const ElementGrid& World::getGridState() const { return m_grid; }
 bool World::isWithinBounds(int r, int c) const { return (r >= 0 && r < m_rows && c >= 0 && c < m_cols); }
-Element* World::getElement(int r, int c) const { if (isWithinBounds(r, c)) { return m_grid[r][c].get(); } else { return nullptr; } }
-Element* World::getElementFromNext(int r, int c) const { if (isWithinBounds(r, c)) { return m_nextGrid[r][c].get(); } else { return nullptr; } }
+Element* World::getElement(int r, int c) const { if (isWithinBounds(r, c)) { return m_grid[index(r, c)].get(); } else { return nullptr; } }
+bool World::isClaimedThisTick(int r, int c) const { return isWithinBounds(r, c) && isClaimed(index(r, c)); }
 ParticleType World::getElementType(int r, int c) const { Element* element = getElement(r, c); if (element) { return element->getType(); } else { return ParticleType::EMPTY; } }
 
 
@@ -68,183 +107,641 @@ void World::setElementByType(int r, int c, ParticleType type) {
     }
     
 	// Create a new element of the specified type
-	std::unique_ptr<Element> newElement = createElementByType(type); // Create the element
-	m_grid[r][c] = std::move(newElement);                            // Move it's unique_ptr to the grid
+	ElementPtr newElement = createElementByType(type, r, c); // Create the element
+	const int idx = index(r, c);
+	const bool wasOccupied = m_grid[idx] != nullptr;
+	m_grid[idx] = std::move(newElement);               // Move it's pointer to the grid
+	markChanged(r, c);                                 // Make sure its chunk processes (and redraws) it next tick
+	syncAwakeBit(idx);                                 // New elements start awake
+
+	// Keep the column's surface height current (never called during the sweep, so rescan now)
+	if (m_grid[idx]) {
+		noteCellOccupied(r, c);
+	}
+	else if (wasOccupied) {
+		refreshSegmentTop((r / CHUNK_SIZE) * m_cols + c);
+	}
 }
 
 
 // **=== Main Simulation Update ===**
 
 void World::update() {
+    ScopedTimer updateTimer(m_profiler, ProfilePhase::WorldUpdate);
+    FS_TRACE_SCOPE("World::update");
+
     // --- Step 0: Process Placement Requests ---
     // Process any pending element placements requested since last update
-    for (const auto& request : m_placementRequests) {
-        // Ensure setElementByType handles potential out-of-bounds internally or check here
-        if (isWithinBounds(request.r, request.c)) {
-            setElementByType(request.r, request.c, request.type); // Place the element
-            wakeNeighbors(request.r, request.c); // Wake up neighbors around the new particle
+    {
+        ScopedTimer timer(m_profiler, ProfilePhase::Placements);
+        FS_TRACE_SCOPE("Placements");
+        for (const auto& request : m_placementRequests) {
+            // Ensure setElementByType handles potential out-of-bounds internally or check here
+            if (isWithinBounds(request.r, request.c)) {
+                setElementByType(request.r, request.c, request.type); // Place the element
+                requestWake(request.r, request.c, getWakeRadius(request.type)); // Wake up neighbors around the new particle
+                ++threadScratch().stats.of(request.type).wakes;
+            }
         }
+        m_placementRequests.clear(); // Clear requests after processing
     }
-    m_placementRequests.clear(); // Clear requests after processing
 
 
     // --- Step 1: Prepare for the new tick ---
-	// Calculate surface heights for the current grid
-    calculateSurfaceHeights();
-	// Clear the next grid and reset update flags
-    for (int r = 0; r < m_rows; ++r) {
-        for (int c = 0; c < m_cols; ++c) {
-            if (m_grid[r][c]) {
-                m_grid[r][c]->resetUpdateFlag();
-            }
-            m_nextGrid[r][c] = nullptr;
-        }
+    {
+        // Wake everything near last tick's moves and this tick's placements (marks their cells dirty)
+        ScopedTimer timer(m_profiler, ProfilePhase::Wakes);
+        FS_TRACE_SCOPE("Wakes");
+        applyWakeRequests();
+    }
+    {
+        ScopedTimer timer(m_profiler, ProfilePhase::TickSetup);
+        FS_TRACE_SCOPE("Tick Setup");
+        // Promote pending dirty rectangles
+        beginChunkTick();
+        // New epoch: every claim stamp from the previous tick is now stale
+        advanceTickEpoch();
     }
 
     // --- Step 2: Update active elements ---
+    {
+        ScopedTimer timer(m_profiler, ProfilePhase::Sweep);
+        FS_TRACE_SCOPE("Sweep");
+        if (getThreadCount() > 1) {
+            updateParallel();
+        }
+        else {
+            updateSerial();
+        }
+    }
+    // Toggle sweep direction for the NEXT frame
+    m_sweepRight = !m_sweepRight;
+    ++m_tickCount;
+
+    // --- Step 3: Tidy up after the sweep ---
+    {
+        // Free elements replaced during the sweep, collect the threads' event counters
+        ScopedTimer timer(m_profiler, ProfilePhase::Cleanup);
+        FS_TRACE_SCOPE("Cleanup");
+        releaseRetiredElements();
+        mergeThreadStats();
+    }
+    {
+        // Finish surface heights whose top cell was emptied
+        ScopedTimer timer(m_profiler, ProfilePhase::SurfaceHeights);
+        FS_TRACE_SCOPE("Surface Heights");
+        resolveStaleSegments();
+        if (m_validateSurfaceHeights) {
+            validateSurfaceHeights();
+        }
+    }
+}
+
+void World::setJobSystem(JobSystem* jobs) {
+    m_jobs = jobs;
+    m_threadScratch.resize(static_cast<size_t>(getThreadCount())); // One set of sweep lists per thread
+}
+
+int World::getThreadCount() const {
+    return m_jobs ? m_jobs->getThreadCount() : 1;
+}
+
+void World::setSeed(std::uint64_t seed) {
+    m_seed = seed;
+    for (size_t i = 0; i < m_chunks.size(); ++i) {
+        m_chunks[i].random.seed(seed, i); // One independent stream per chunk
+    }
+}
+
+void World::updateSerial() {
+    // Rows still go bottom-up across the whole world; within a row only the
+    // current rectangles of active chunks are visited.
     for (int r = m_rows - 1; r >= 0; --r) { // Iterate from bottom row upwards
+        const int chunkRowStart = (r / CHUNK_SIZE) * m_chunkCols;
         // Alternate column direction based on m_sweepRight
         if (m_sweepRight) {
             // Sweep Left-to-Right
-            for (int c = 0; c < m_cols; ++c) {
-                Element* element = m_grid[r][c].get();
-                if (element && !element->isUpdatedThisTick() && element->isAwake()) {
-                    element->update(*this, r, c);
+            for (int cc = 0; cc < m_chunkCols; ++cc) {
+                const WorldChunk& chunk = m_chunks[chunkRowStart + cc];
+                if (chunk.current.containsRow(r)) {
+                    updateChunkRow(r, chunk.current.minC, chunk.current.maxC);
                 }
             }
         }
         else {
             // Sweep Right-to-Left
-            for (int c = m_cols - 1; c >= 0; --c) {
-                Element* element = m_grid[r][c].get();
-                if (element && !element->isUpdatedThisTick() && element->isAwake()) {
-                    element->update(*this, r, c);
+            for (int cc = m_chunkCols - 1; cc >= 0; --cc) {
+                const WorldChunk& chunk = m_chunks[chunkRowStart + cc];
+                if (chunk.current.containsRow(r)) {
+                    updateChunkRow(r, chunk.current.minC, chunk.current.maxC);
                 }
             }
         }
     }
-    // Toggle sweep direction for the NEXT frame
-    m_sweepRight = !m_sweepRight;
+}
 
-    // --- Step 3: Handle stationary elements ---
-	// Copy any stationary elements from m_grid to m_nextGrid
-    for (int r = 0; r < m_rows; ++r) {
-        for (int c = 0; c < m_cols; ++c) {
-            if (m_grid[r][c] && !m_nextGrid[r][c]) {
-                m_nextGrid[r][c] = std::move(m_grid[r][c]);
+void World::updateParallel() {
+    // The phases are made of chunk-sized tiles, not the chunks themselves, and the tile
+    // grid moves every tick. With fixed boundaries the tile updated first would claim the
+    // cells along its edge every tick (a waterfall down an edge column claims all of it),
+    // so liquids could only cross at the top and stood in walls along the chunk edges.
+    const int offsetR = static_cast<int>((m_tickCount * TILE_SHIFT_ROWS) % CHUNK_SIZE);
+    const int offsetC = static_cast<int>((m_tickCount * TILE_SHIFT_COLS) % CHUNK_SIZE);
+    const int tileRows = (m_rows + offsetR + CHUNK_SIZE - 1) / CHUNK_SIZE;
+    const int tileCols = (m_cols + offsetC + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+    // Sort tiles with work into checkerboard phases by (row parity, column parity).
+    // Bottom tile rows are listed first so gravity-heavy work starts early.
+    for (std::vector<DirtyRect>& phase : m_phaseTiles) {
+        phase.clear();
+    }
+    for (int tr = tileRows - 1; tr >= 0; --tr) {
+        for (int tc = 0; tc < tileCols; ++tc) {
+            DirtyRect tile;
+            tile.minR = std::max(tr * CHUNK_SIZE - offsetR, 0);
+            tile.minC = std::max(tc * CHUNK_SIZE - offsetC, 0);
+            tile.maxR = std::min((tr + 1) * CHUNK_SIZE - offsetR, m_rows) - 1;
+            tile.maxC = std::min((tc + 1) * CHUNK_SIZE - offsetC, m_cols) - 1;
+            if (tileHasWork(tile)) {
+                m_phaseTiles[(tr % 2) * 2 + (tc % 2)].push_back(tile);
             }
         }
     }
 
-    // --- Step 4: Swap grids ---
-    m_grid.swap(m_nextGrid);
+    // Each phase must finish before the next starts, since neighbouring tiles
+    // (which are in other phases) overlap each other's neighbourhoods.
+    // Grain 1: load is very uneven (a waterfall next to sleeping tiles), so
+    // jobs are kept as small as parallelFor allows (one tile each, unless a
+    // phase has more than ~8 tiles per thread) for idle threads to steal.
+    for (const std::vector<DirtyRect>& phase : m_phaseTiles) {
+        FS_TRACE_SCOPE("Checkerboard Phase");
+        m_jobs->parallelFor(0, static_cast<int>(phase.size()), 1, [&](int begin, int end) {
+            for (int i = begin; i < end; ++i) {
+                FS_TRACE_SCOPE("Tile");
+                updateTile(phase[i]);
+            }
+        });
+    }
 }
 
-void World::requestPlacement(int r, int c, ParticleType type) {
-    m_placementRequests.push_back({ r, c, type });
+bool World::tileHasWork(const DirtyRect& tile) const {
+    // A tile covers parts of at most four chunks
+    for (int cr = tile.minR / CHUNK_SIZE; cr <= tile.maxR / CHUNK_SIZE; ++cr) {
+        for (int cc = tile.minC / CHUNK_SIZE; cc <= tile.maxC / CHUNK_SIZE; ++cc) {
+            const DirtyRect& current = m_chunks[cr * m_chunkCols + cc].current;
+            if (current.minR <= tile.maxR && current.maxR >= tile.minR && current.minC <= tile.maxC && current.maxC >= tile.minC) {
+                return true;
+            }
+        }
+    }
+    return false;
 }
 
-// **=== Element Interaction Methods ===**
+void World::updateTile(const DirtyRect& tile) {
+    // Bottom-up; each row crosses at most two chunks, visited in the sweep direction
+    const int firstChunkCol = tile.minC / CHUNK_SIZE;
+    const int lastChunkCol = tile.maxC / CHUNK_SIZE;
+    for (int r = tile.maxR; r >= tile.minR; --r) {
+        const int chunkRowStart = (r / CHUNK_SIZE) * m_chunkCols;
+        for (int i = 0; i <= lastChunkCol - firstChunkCol; ++i) {
+            const int cc = m_sweepRight ? firstChunkCol + i : lastChunkCol - i;
+            const DirtyRect& current = m_chunks[chunkRowStart + cc].current;
+            const int minC = std::max(current.minC, tile.minC);
+            const int maxC = std::min(current.maxC, tile.maxC);
+            if (current.containsRow(r) && minC <= maxC) {
+                updateChunkRow(r, minC, maxC);
+            }
+        }
+    }
+}
+
+void World::updateChunkRow(int r, int minC, int maxC) {
+    ThreadScratch& scratch = threadScratch();
+    if (m_batchByType) {
+        updateChunkRowBatched(r, minC, maxC, scratch);
+        return;
+    }
+
+    const int rowStart = index(r, 0);
+    SimulationStats& stats = scratch.stats;
+    // Walk only the awake bits between the two columns. The word is re-read
+    // after every update, since an update may wake, move or sleep cells further along.
+    const int lo = rowStart + minC;
+    const int hi = rowStart + maxC;
+    if (m_sweepRight) {
+        // Sweep Left-to-Right: lowest set bit first
+        int idx = lo;
+        while (idx <= hi) {
+            const std::uint64_t bits = m_awakeBits[idx >> 6].load(std::memory_order_relaxed) & (~std::uint64_t{ 0 } << (idx & 63));
+            if (!bits) {
+                idx = (idx | 63) + 1; // Rest of the word is asleep, go to the next one
+                continue;
+            }
+            idx = (idx & ~63) + std::countr_zero(bits);
+            if (idx > hi) {
+                break;
+            }
+            updateCell(r, idx - rowStart, idx, stats);
+            ++idx;
+        }
+    }
+    else {
+        // Sweep Right-to-Left: highest set bit first
+        int idx = hi;
+        while (idx >= lo) {
+            const std::uint64_t bits = m_awakeBits[idx >> 6].load(std::memory_order_relaxed) & (~std::uint64_t{ 0 } >> (63 - (idx & 63)));
+            if (!bits) {
+                idx = (idx & ~63) - 1; // Rest of the word is asleep, go to the previous one
+                continue;
+            }
+            idx = (idx & ~63) + 63 - std::countl_zero(bits);
+            if (idx < lo) {
+                break;
+            }
+            updateCell(r, idx - rowStart, idx, stats);
+            --idx;
+        }
+    }
+}
+
+void World::updateCell(int r, int c, int idx, SimulationStats& stats) {
+    Element* element = m_grid[idx].get();
+    // Claimed cells hold an element that arrived this tick and has already had its turn
+    if (!element || isClaimed(idx)) {
+        return;
+    }
+    TypeEventCounts& counts = stats.of(element->getType());
+    ++counts.updates;
+    dispatchUpdate(*element, r, c);
+    finishCellUpdate(element, r, c, idx, counts);
+}
+
+void World::finishCellUpdate(const Element* element, int r, int c, int idx, TypeEventCounts& counts) {
+    // Elements that stay awake in place keep their cell dirty for the next tick
+    // (moved elements are marked at their destination by tryMoveOrSwap)
+    Element* after = m_grid[idx].get();
+    if (after && after->isAwake()) {
+        markDirty(r, c);
+        setAwakeBit(idx);
+    }
+    else {
+        if (after == element) {
+            ++counts.sleeps; // Still here, so it fell asleep
+        }
+        clearAwakeBit(idx); // Moved away or fell asleep
+    }
+}
+
+template <typename Kernel>
+void World::runUpdateBatch(const std::vector<int>& batch, int r, int rowStart, TypeEventCounts& counts, const Kernel& kernel) {
+    for (int idx : batch) {
+        Element* element = m_grid[idx].get();
+        // An earlier update in the row may have moved this element away (the cell is then empty or claimed)
+        if (!element || isClaimed(idx)) {
+            continue;
+        }
+        ++counts.updates;
+        kernel(*element, r, idx - rowStart);
+        finishCellUpdate(element, r, idx - rowStart, idx, counts);
+    }
+}
+
+void World::updateChunkRowBatched(int r, int minC, int maxC, ThreadScratch& scratch) {
+    const int rowStart = index(r, 0);
+    const int lo = rowStart + minC;
+    const int hi = rowStart + maxC;
+
+    // --- Gather: the row's awake cells, in sweep order, one list per type ---
+    // The awake bits are read once up front. That finds the same cells as the
+    // row-order walk: an update only wakes or fills cells it also claims, and
+    // claimed cells are skipped either way.
+    for (std::vector<int>& batch : scratch.typeBatches) {
+        batch.clear();
+    }
+    auto gather = [&](int idx) {
+        const Element* element = m_grid[idx].get();
+        if (element && !isClaimed(idx)) {
+            scratch.typeBatches[static_cast<size_t>(element->getType())].push_back(idx);
+        }
+    };
+    const int firstWord = lo >> 6;
+    const int lastWord = hi >> 6;
+    auto rowBits = [&](int w) { // The word's awake bits that lie between lo and hi
+        std::uint64_t bits = m_awakeBits[w].load(std::memory_order_relaxed);
+        if (w == firstWord) {
+            bits &= ~std::uint64_t{ 0 } << (lo & 63);
+        }
+        if (w == lastWord) {
+            bits &= ~std::uint64_t{ 0 } >> (63 - (hi & 63));
+        }
+        return bits;
+    };
+    if (m_sweepRight) {
+        for (int w = firstWord; w <= lastWord; ++w) {
+            for (std::uint64_t bits = rowBits(w); bits; bits &= bits - 1) { // Lowest set bit first
+                gather((w << 6) + std::countr_zero(bits));
+            }
+        }
+    }
+    else {
+        for (int w = lastWord; w >= firstWord; --w) {
+            std::uint64_t bits = rowBits(w);
+            while (bits) { // Highest set bit first
+                const int bit = 63 - std::countl_zero(bits);
+                gather((w << 6) + bit);
+                bits &= ~(std::uint64_t{ 1 } << bit);
+            }
+        }
+    }
+
+    // --- Run: each type's update over its batch, types in enum order ---
+    // Each batch is its own trace scope, named after the class
+    for (size_t t = 0; t < PARTICLE_TYPE_COUNT; ++t) {
+        const std::vector<int>& batch = scratch.typeBatches[t];
+        if (batch.empty()) {
+            continue;
+        }
+        TypeEventCounts& counts = scratch.stats.types[t];
+        switch (static_cast<ParticleType>(t)) {
+#define FS_RUN_BATCH(TYPE, CLASS) \
+        case ParticleType::TYPE: { \
+            FS_TRACE_SCOPE(#CLASS " Batch"); \
+            runUpdateBatch(batch, r, rowStart, counts, [this](Element& element, int row, int col) { static_cast<CLASS&>(element).CLASS::update(*this, row, col); }); \
+            break; \
+        }
+        FS_FOR_EACH_ELEMENT_CLASS(FS_RUN_BATCH)
+#undef FS_RUN_BATCH
+        default: { // No registered class: use the vtable
+            FS_TRACE_SCOPE("Element Batch");
+            runUpdateBatch(batch, r, rowStart, counts, [this](Element& element, int row, int col) {
+                element.update(*this, row, col);
+            });
+            break;
+        }
+        }
+    }
+}
+
+void World::dispatchUpdate(Element& element, int r, int c) {
+    // Qualified calls are direct (and can be inlined), unlike element.update()
+    switch (element.getType()) {
+#define FS_UPDATE_KERNEL(TYPE, CLASS) \
+    case ParticleType::TYPE: static_cast<CLASS&>(element).CLASS::update(*this, r, c); return;
+    FS_FOR_EACH_ELEMENT_CLASS(FS_UPDATE_KERNEL)
+#undef FS_UPDATE_KERNEL
+    default: element.update(*this, r, c); return; // No registered class: use the vtable
+    }
+}
+
+// **=== Chunk Management ===**
+
+void World::beginChunkTick() {
+    m_activeChunkCount = 0;
+    for (WorldChunk& chunk : m_chunks) {
+        chunk.current = chunk.pending.take();
+        if (chunk.isActive()) {
+            ++m_activeChunkCount;
+        }
+    }
+}
+
+void World::takeChangedAreas(std::vector<DirtyRect>& areas) {
+    areas.clear();
+    for (WorldChunk& chunk : m_chunks) {
+        const DirtyRect area = chunk.changed.take();
+        if (!area.isEmpty()) {
+            areas.push_back(area);
+        }
+    }
+}
+
+int World::getAwakeCellCount() const {
+    int count = 0;
+    for (const std::atomic<std::uint64_t>& word : m_awakeBits) {
+        count += std::popcount(word.load(std::memory_order_relaxed));
+    }
+    return count;
+}
+
+// **=== Claim Stamps & Retired Elements ===**
+
+void World::advanceTickEpoch() {
+    if (++m_tickEpoch == 0) {
+        // Wrapped around: stamps from 65535 ticks ago would look like fresh claims
+        std::fill(m_claimStamps.begin(), m_claimStamps.end(), std::uint16_t{ 0 });
+        m_tickEpoch = 1;
+    }
+}
+
+World::ThreadScratch& World::threadScratch() {
+    // Worker threads have their own lists; everything else (including a serial update) uses entry 0
+    const size_t slot = getThreadCount() > 1 ? static_cast<size_t>(JobSystem::currentWorkerIndex()) : 0;
+    if (slot >= m_threadScratch.size()) {
+        throw std::logic_error("World sweep lists used from a thread outside the World's job system.");
+    }
+    return m_threadScratch[slot];
+}
+
+void World::retireElement(ElementPtr element) {
+    if (element) {
+        threadScratch().retiredElements.push_back(std::move(element));
+    }
+}
+
+void World::releaseRetiredElements() {
+    for (ThreadScratch& scratch : m_threadScratch) {
+        scratch.retiredElements.clear(); // Returns the elements to their pools
+    }
+}
+
+void World::mergeThreadStats() {
+    m_lastTickStats.clear();
+    for (ThreadScratch& scratch : m_threadScratch) {
+        m_lastTickStats.add(scratch.stats);
+        scratch.stats.clear();
+    }
+    m_totalStats.add(m_lastTickStats);
+}
+
+// **=== Surface Heights ===**
+
+void World::noteCellOccupied(int r, int c) {
+    // Lower the segment's top to this row if it is higher up; several threads may race here
+    std::atomic<std::uint8_t>& top = m_segmentTops[static_cast<size_t>(r / CHUNK_SIZE) * m_cols + c];
+    const std::uint8_t row = static_cast<std::uint8_t>(r % CHUNK_SIZE);
+    std::uint8_t current = top.load(std::memory_order_relaxed);
+    while (row < current && !top.compare_exchange_weak(current, row, std::memory_order_relaxed)) {}
+}
+
+void World::noteCellVacated(int r, int c) {
+    // Only emptying the top cell moves the surface. Cells below may belong to
+    // another thread's neighbourhood right now, so the rescan waits for the sweep to end.
+    const int segment = (r / CHUNK_SIZE) * m_cols + c;
+    if (m_segmentTops[segment].load(std::memory_order_relaxed) == r % CHUNK_SIZE) {
+        threadScratch().staleSegments.push_back(segment);
+    }
+}
+
+void World::refreshSegmentTop(int segment) {
+    const int chunkTop = (segment / m_cols) * CHUNK_SIZE;
+    const int c = segment % m_cols;
+    const int rowsInSegment = std::min(CHUNK_SIZE, m_rows - chunkTop); // The last chunk row may be partial
+
+    // The stored top is never below the real one, so scan down from it
+    int top = m_segmentTops[segment].load(std::memory_order_relaxed);
+    while (top < rowsInSegment && !m_grid[index(chunkTop + top, c)]) {
+        ++top;
+    }
+    m_segmentTops[segment].store(static_cast<std::uint8_t>(top < rowsInSegment ? top : CHUNK_SIZE), std::memory_order_relaxed);
+}
 
-void World::calculateSurfaceHeights() {
+void World::resolveStaleSegments() {
+    for (ThreadScratch& scratch : m_threadScratch) {
+        for (int segment : scratch.staleSegments) {
+            refreshSegmentTop(segment); // Duplicates are harmless, the second rescan stops at once
+        }
+        scratch.staleSegments.clear();
+    }
+}
+
+void World::validateSurfaceHeights() const {
     for (int c = 0; c < m_cols; ++c) {
-        m_surfaceHeights[c] = m_rows; // Default to bottom (empty column)
+        int expected = m_rows; // Default to bottom (empty column)
         for (int r = 0; r < m_rows; ++r) {
-            if (m_grid[r][c]) { // Found the first non-empty cell from the top
-                m_surfaceHeights[c] = r;
-                break; // Stop scanning down this column
+            if (m_grid[index(r, c)]) { // Found the first non-empty cell from the top
+                expected = r;
+                break;
             }
         }
+        const int actual = getSurfaceHeight(c);
+        if (actual != expected) {
+            throw std::logic_error("Surface height of column " + std::to_string(c) + " is " + std::to_string(actual) +
+                ", a full rescan found " + std::to_string(expected) + ".");
+        }
+    }
+}
+
+void World::markDirtyArea(int r0, int c0, int r1, int c1) {
+    // Clip to the grid
+    r0 = std::max(r0, 0);
+    c0 = std::max(c0, 0);
+    r1 = std::min(r1, m_rows - 1);
+    c1 = std::min(c1, m_cols - 1);
+    if (r0 > r1 || c0 > c1) {
+        return;
+    }
+
+    // Add the overlapping part of the area to every chunk it touches
+    for (int cr = r0 / CHUNK_SIZE; cr <= r1 / CHUNK_SIZE; ++cr) {
+        const int chunkTop = cr * CHUNK_SIZE;
+        const int top = std::max(r0, chunkTop);
+        const int bottom = std::min(r1, chunkTop + CHUNK_SIZE - 1);
+        for (int cc = c0 / CHUNK_SIZE; cc <= c1 / CHUNK_SIZE; ++cc) {
+            const int chunkLeft = cc * CHUNK_SIZE;
+            const int left = std::max(c0, chunkLeft);
+            const int right = std::min(c1, chunkLeft + CHUNK_SIZE - 1);
+            m_chunks[cr * m_chunkCols + cc].pending.include(top, left, bottom, right);
+        }
     }
 }
 
+void World::requestPlacement(int r, int c, ParticleType type) {
+    m_placementRequests.push_back({ r, c, type });
+}
+
+// **=== Element Interaction Methods ===**
+
 bool World::tryMoveOrSwap(int r_from, int c_from, int r_to, int c_to) {
-    // Bounds checks
-    if (!isWithinBounds(r_from, c_from) || !isWithinBounds(r_to, c_to)) {
+    // Source bounds check (not counted: there is no mover to charge it to)
+    if (!isWithinBounds(r_from, c_from)) {
         return false;
     }
 
+    const int from = index(r_from, c_from);
+
 	// Check if the source cell is empty
-    if (!m_grid[r_from][c_from]) {
+    if (!m_grid[from]) {
         return false; // Cannot move nothing
     }
 
 	// Get the element that is being moved
-    Element* moverElement = m_grid[r_from][c_from].get();
+    Element* moverElement = m_grid[from].get();
     if (!moverElement) return false; // Safety check
 
-    // Check original target in m_grid first
-    Element* originalTargetElement = getElement(r_to, c_to);
+    // Count the attempt against the mover's type
+    SimulationStats& stats = threadScratch().stats;
+    TypeEventCounts& moverCounts = stats.of(moverElement->getType());
+    ++moverCounts.moveAttempts;
 
-    // Check target cell in NEXT grid (for conflict detection)
-	Element* claimedNextElement = m_nextGrid[r_to][c_to].get(); // Get whats in the next grid target cell
-	bool targetClaimed = claimedNextElement != nullptr;         // If empty, targetClaimed is false
+    // Target bounds check
+    if (!isWithinBounds(r_to, c_to)) {
+        ++moverCounts.failures[static_cast<size_t>(MoveFailure::OutOfBounds)];
+        return false;
+    }
+    const int to = index(r_to, c_to);
 
-    // --- Case A: Original Target was Empty ---
-    if (!originalTargetElement) {
-        // Can only move here if the spot hasn't already been claimed in nextGrid
-        if (targetClaimed) {
-			return false; // Block, target already claimed in nextGrid
-        }
+    // A target that already received an element this tick is taken.
+    // This prevents overwriting a completed move/swap by another particle.
+    if (isClaimed(to)) {
+        ++moverCounts.failures[static_cast<size_t>(MoveFailure::Claimed)];
+        return false; // Blocked, target already claimed this tick
+    }
+
+    // Whatever is in the target now is its original occupant for this tick
+    Element* originalTargetElement = m_grid[to].get();
 
+    // --- Case A: Target is Empty ---
+    if (!originalTargetElement) {
 		// Perform the move
-        m_nextGrid[r_to][c_to] = std::move(m_grid[r_from][c_from]);
-        wakeNeighbors(r_from, c_from);
-        wakeNeighbors(r_to, c_to);
-		if (m_nextGrid[r_to][c_to]) { m_nextGrid[r_to][c_to]->wakeUp(); } // Wake up the moved element
+        m_grid[to] = std::move(m_grid[from]);
+        claimCell(to);
+        clearAwakeBit(from);
+        const int radius = getWakeRadius(m_grid[to]->getType());
+        noteCellOccupied(r_to, c_to); // Fill first: after an upward move the emptied cell is then no longer the top
+        noteCellVacated(r_from, c_from);
+        markChanged(r_from, c_from);
+        markChanged(r_to, c_to);
+        requestWake(r_from, c_from, radius);
+        requestWake(r_to, c_to, radius);
+		m_grid[to]->wakeUp(); // Wake up the moved element
+        setAwakeBit(to);
+        ++moverCounts.moves;
+        moverCounts.wakes += radius > 0 ? 2 : 0;
         return true;
     }
 
-    // --- Case B: Original Target was Occupied ---
+    // --- Case B: Target is Occupied ---
     else {
-        // If the target spot in nextGrid is already claimed by something
-        // *other* than the particle originally there, then it's a conflict.
-        // This prevents overwriting a completed move/swap by another particle.
-        if (targetClaimed && claimedNextElement != originalTargetElement) {
-            return false; // Blocked by a third-party claim/move into the target spot
-        }
-
-        // If we passed the check above, the target spot in nextGrid is either
-        // empty (targetClaimed is false) OR claimed by the original target element itself.
-
-		// -- Check if original target is a displaceable Liquid --
-        float moverDensity = 0.0f; // Get mover density safely
-        bool densityObtained = false;
-		// Get the density of the mover element for each type
-        if (Solid* solidMover = dynamic_cast<Solid*>(moverElement)) { moverDensity = solidMover->getDensity(); densityObtained = true; }
-        else if (Liquid* liquidMover = dynamic_cast<Liquid*>(moverElement)) { moverDensity = liquidMover->getDensity(); densityObtained = true; }
-        else if (Gas* gasMover = dynamic_cast<Gas*>(moverElement)) { moverDensity = gasMover->getDensity(); densityObtained = true; }
-        if (!densityObtained) return false; // Should not happen
-
-		// Fluid density check for if original target is a fluid (Liquid or Gas)
-        float targetDensity = 0.0f; // Get target density if fluid
-        bool isFluid = false;
-        if (Liquid* liquidTarget = dynamic_cast<Liquid*>(originalTargetElement)) { isFluid = true; targetDensity = liquidTarget->getDensity(); }
-        else if (Gas* gasTarget = dynamic_cast<Gas*>(originalTargetElement)) { isFluid = true; targetDensity = gasTarget->getDensity(); }
-
+		// -- Check if original target is a displaceable fluid (Liquid or Gas) --
+        // Densities and phases come from the trait table, one load per element
+        const ElementTraits& moverTraits = moverElement->getTraits();
+        const ElementTraits& targetTraits = originalTargetElement->getTraits();
 
         // --- Density Check ---
-        if (isFluid && moverDensity > targetDensity) {
-            // Perform the SWAP
-			std::unique_ptr<Element> originalTargetPtr = std::move(m_grid[r_to][c_to]); // Store original target before moving
-			m_nextGrid[r_to][c_to] = std::move(m_grid[r_from][c_from]);                 // Move the mover to target cell
-            // Only move target back if the source spot wasn't claimed by something else
-            if (!m_nextGrid[r_from][c_from]) {
-                m_nextGrid[r_from][c_from] = std::move(originalTargetPtr);   // Target takes mover's original spot in next
-            }
-            else {
-                // Displaced fluid is lost if source spot taken. originalTargetPtr is deleted.
-            }
-
-            // Wake up relevant particles
-            wakeNeighbors(r_from, c_from);
-            wakeNeighbors(r_to, c_to);
-            if (m_nextGrid[r_to][c_to]) { m_nextGrid[r_to][c_to]->wakeUp(); }
-            if (m_nextGrid[r_from][c_from]) { m_nextGrid[r_from][c_from]->wakeUp(); }
+        if (targetTraits.isFluid() && moverTraits.density > targetTraits.density) {
+            // Perform the SWAP; both cells now hold an element that has had its turn this tick
+            std::swap(m_grid[from], m_grid[to]);
+            claimCell(from);
+            claimCell(to);
+
+            // Dirty both cells and wake up relevant particles
+            const int radius = getWakeRadius(moverElement->getType());
+            markChanged(r_from, c_from);
+            markChanged(r_to, c_to);
+            requestWake(r_from, c_from, radius);
+            requestWake(r_to, c_to, radius);
+            m_grid[to]->wakeUp();
+            m_grid[from]->wakeUp();
+            setAwakeBit(to);
+            setAwakeBit(from);
+            ++moverCounts.swaps;
+            ++stats.of(originalTargetElement->getType()).displaced;
+            moverCounts.wakes += radius > 0 ? 2 : 0;
             return true; // Swap succeeded
         }
         else {
             // Blocked by solid or denser/equal fluid
+            ++moverCounts.failures[static_cast<size_t>(MoveFailure::Blocked)];
             return false;
         }
     }
@@ -253,62 +750,198 @@ bool World::tryMoveOrSwap(int r_from, int c_from, int r_to, int c_to) {
 
 // --- Other World Member Functions ---
 
-void World::setNextElement(int r, int c, std::unique_ptr<Element> element) {
+void World::replaceElement(int r, int c, ElementPtr element) {
 	if (isWithinBounds(r, c)) { // Check bounds
-		m_nextGrid[r][c] = std::move(element); // Move the element into the next grid
+        const int idx = index(r, c);
+        const ParticleType oldType = m_grid[idx] ? m_grid[idx]->getType() : ParticleType::EMPTY;
+        const ParticleType newType = element ? element->getType() : ParticleType::EMPTY;
+        ++threadScratch().stats.transitions[static_cast<size_t>(oldType)][static_cast<size_t>(newType)];
+		retireElement(std::move(m_grid[idx])); // The old element may still be running its update
+		m_grid[idx] = std::move(element);      // Move the new element into the grid
+		claimCell(idx);                        // It takes its first turn next tick
+		markChanged(r, c);
+		syncAwakeBit(idx);
+		if (m_grid[idx]) {
+			noteCellOccupied(r, c);
+		}
+		else {
+			noteCellVacated(r, c);
+		}
     }
 }
 
-void World::clearNextGridCell(int r, int c) {
-	if (isWithinBounds(r, c)) { // Check bounds
-		m_nextGrid[r][c] = nullptr; // Clear the cell in the next grid
+bool World::morphElement(int r, int c, ParticleType newType) {
+    if (!isWithinBounds(r, c)) {
+        return false;
+    }
+    const int idx = index(r, c);
+    Element* element = m_grid[idx].get();
+    if (!element || element->getType() == newType) {
+        return false;
     }
+    const ParticleType oldType = element->getType();
+    const Element::MorphState previous = element->getMorphState();
+
+    // Rebuild the element in its own slot; the grid lets go of it first, so a throwing constructor cannot leave it dangling
+    Element* morphed = nullptr;
+    m_grid[idx].release();
+    switch (newType) {
+#define FS_MORPH_ELEMENT(TYPE, CLASS) \
+    case ParticleType::TYPE: morphed = ElementPool::morph<CLASS>(element); break;
+    FS_FOR_EACH_ELEMENT_CLASS(FS_MORPH_ELEMENT)
+#undef FS_MORPH_ELEMENT
+    default:
+        m_grid[idx].reset(element);
+        return false; // EMPTY, or no element class yet (e.g. STEAM)
+    }
+
+    if (!morphed) {
+        // Unpooled, or the new class is larger than the old slot: allocate after all
+        m_grid[idx].reset(element);
+        ElementPtr replacement = createElementByType(newType, r, c);
+        replacement->inheritMorphState(previous);
+        replaceElement(r, c, std::move(replacement));
+        return true;
+    }
+
+    m_grid[idx].reset(morphed);
+    morphed->inheritMorphState(previous);
+    ++threadScratch().stats.transitions[static_cast<size_t>(oldType)][static_cast<size_t>(newType)];
+    claimCell(idx); // It takes its first turn next tick
+    markChanged(r, c);
+    syncAwakeBit(idx);
+    return true;
 }
 
-void World::moveElementToNext(int r_from, int c_from, int r_to, int c_to) {
-	if (!isWithinBounds(r_from, c_from) || !isWithinBounds(r_to, c_to)) { // Check bounds of both cells
-		return; // Cannot move out of bounds
+// **=== Factory for Creating Elements ===**
+
+ElementPtr World::createElementByType(ParticleType type, int r, int c) {
+	// Create a new element based on the ParticleType, in that type's pool
+    ElementPtr element;
+    switch (type) {
+#define FS_MAKE_ELEMENT(TYPE, CLASS) \
+    case ParticleType::TYPE: element = makePooled<CLASS>(type); break;
+    FS_FOR_EACH_ELEMENT_CLASS(FS_MAKE_ELEMENT)
+#undef FS_MAKE_ELEMENT
+    default:                 return nullptr; // EMPTY, or no element class yet
     }
-	if (!m_grid[r_from][c_from]) { // Check if the source cell is empty
-		return; // Cannot move nothing
+    element->seedColorVariant(r, c);
+    return element;
+}
+
+// **=== Pool Stats ===**
+
+ElementPoolStats World::getPoolStats(ParticleType type) const {
+    const std::unique_ptr<ElementPool>& pool = m_pools[static_cast<size_t>(type)];
+    if (pool) {
+        return pool->getStats();
     }
-	m_nextGrid[r_to][c_to] = std::move(m_grid[r_from][c_from]); // Move the element to the next grid
+    ElementPoolStats empty;
+    empty.type = type;
+    return empty;
 }
 
-void World::swapElementsInNext(int r1, int c1, int r2, int c2) {
-    //TODO: Check if actually using this func
-	if (!isWithinBounds(r1, c1) || !isWithinBounds(r2, c2)) { // Check bounds of both cells
+ElementPoolStats World::getTotalPoolStats() const {
+    ElementPoolStats total;
+    for (const std::unique_ptr<ElementPool>& pool : m_pools) {
+        if (pool) {
+            ElementPoolStats stats = pool->getStats();
+            total.capacity += stats.capacity;
+            total.inUse += stats.inUse;
+            total.peakInUse += stats.peakInUse;
+            total.slotsInUse += stats.slotsInUse;
+            total.slabCount += stats.slabCount;
+        }
+    }
+    return total;
+}
+
+void World::setWakeRadius(ParticleType type, int radius) {
+    if (radius < 0 || radius > MAX_WAKE_RADIUS) {
+        throw std::out_of_range("Wake radius " + std::to_string(radius) + " is outside 0.." + std::to_string(MAX_WAKE_RADIUS) + ".");
+    }
+    m_wakeRadius[static_cast<size_t>(type)] = radius;
+}
+
+void World::applyWakeRequests() {
+    const DirtyRect area = m_wakeArea.take();
+    if (area.isEmpty()) {
         return;
     }
-	m_nextGrid[r2][c2] = std::move(m_grid[r1][c1]); // Move the element from r1,c1 to r2,c2
-	m_nextGrid[r1][c1] = std::move(m_grid[r2][c2]); // Move the element from r2,c2 to r1,c1
+
+    // Every row within reach of a request; rows are independent, so they can be split across threads
+    const int firstRow = std::max(area.minR - MAX_WAKE_RADIUS, 0);
+    const int lastRow = std::min(area.maxR + MAX_WAKE_RADIUS, m_rows - 1);
+    if (getThreadCount() > 1) {
+        m_jobs->parallelFor(firstRow, lastRow + 1, 8, [this](int begin, int end) {
+            for (int r = begin; r < end; ++r) {
+                applyWakeRow(r);
+            }
+        });
+    }
+    else {
+        for (int r = firstRow; r <= lastRow; ++r) {
+            applyWakeRow(r);
+        }
+    }
+
+    // Clear the requests (all of them lie in the area's rows)
+    const int firstWord = index(area.minR, 0) >> 6;
+    const int lastWord = (index(area.maxR, 0) + m_stride - 1) >> 6;
+    for (std::vector<std::atomic<std::uint64_t>>& requests : m_wakeRequests) {
+        for (int w = firstWord; w <= lastWord; ++w) {
+            requests[w].store(0, std::memory_order_relaxed);
+        }
+    }
 }
 
-// **=== Factory for Creating Elements ===**
+void World::applyWakeRow(int r) {
+    const int rowStart = index(r, 0);
+    const int rowEnd = rowStart + m_cols; // One past the last real cell
+
+    for (int base = rowStart & ~63; base < rowEnd; base += 64) {
+        // Dilate: OR together the request bits shifted by every offset within each radius.
+        // The row padding (>= MAX_WAKE_RADIUS cells) keeps horizontal shifts from reaching the next row.
+        std::uint64_t wake = 0;
+        for (int radius = 1; radius <= MAX_WAKE_RADIUS; ++radius) {
+            const std::vector<std::atomic<std::uint64_t>>& requests = m_wakeRequests[radius - 1];
+            for (int dr = -radius; dr <= radius; ++dr) {
+                for (int dc = -radius; dc <= radius; ++dc) {
+                    wake |= loadBitWindow(requests, base + neighborOffset(dr, dc));
+                }
+            }
+        }
 
-std::unique_ptr<Element> World::createElementByType(ParticleType type) {
-	// Create a new element based on the ParticleType
-    switch (type) {
-    case ParticleType::EMPTY:   return nullptr;
-    case ParticleType::SAND:    return std::make_unique<SandElement>();
-    case ParticleType::DIRT:    return std::make_unique<DirtElement>();
-    case ParticleType::GRASS:   return std::make_unique<GrassElement>();
-    case ParticleType::WATER:   return std::make_unique<WaterElement>();
-    default:                    return nullptr;
-    }
-}
-
-void World::wakeNeighbors(int r, int c) {
-	for (int dr = -2; dr <= 2; ++dr) {     // Check rows range -2 to 2
-		for (int dc = -2; dc <= 2; ++dc) { // Check columns range -2 to 2
-			if (dr == 0 && dc == 0) continue; // Skip self
-			// Calculate neighbor coordinates
-            int nr = r + dr;
-            int nc = c + dc;
-			Element* neighbor = getElement(nr, nc); // Get the neighbor element
-			if (neighbor) {         // If the neighbor exists
-				neighbor->wakeUp(); // Wake it up
+        // Keep only this row's real cells
+        if (base < rowStart) {
+            wake &= ~std::uint64_t{ 0 } << (rowStart - base);
+        }
+        if (rowEnd - base < 64) {
+            wake &= ~(~std::uint64_t{ 0 } << (rowEnd - base));
+        }
+
+        // Wake whatever is there
+        while (wake) {
+            const int idx = base + std::countr_zero(wake);
+            wake &= wake - 1; // Clear the lowest set bit
+            Element* element = m_grid[idx].get();
+            if (element) {
+                element->wakeUp();
+                setAwakeBit(idx);
+                markDirty(r, idx - rowStart); // Whatever is woken must be visited next tick
             }
         }
     }
+}
+
+std::uint64_t World::loadBitWindow(const std::vector<std::atomic<std::uint64_t>>& bits, int bit) {
+    const int word = bit >> 6; // Floor division, also for negative positions
+    const int shift = bit & 63;
+    const int wordCount = static_cast<int>(bits.size());
+    const std::uint64_t low = (word >= 0 && word < wordCount) ? bits[word].load(std::memory_order_relaxed) : 0;
+    if (shift == 0) {
+        return low;
+    }
+    const std::uint64_t high = (word + 1 >= 0 && word + 1 < wordCount) ? bits[word + 1].load(std::memory_order_relaxed) : 0;
+    return (low >> shift) | (high << (64 - shift));
 }
\ No newline at end of file
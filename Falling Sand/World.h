@@ -3,8 +3,8 @@
 // File:        World.h
 // Author:      Foster Rae
 // Date Created:2025-04-23
-// Last Update: 2025-04-26
-// Version:     1.6
+// Last Update: 2026-10-16
+// Version:     2.15
 // Description: Header file for the World class.
 //              Manages the grid of Elements and handles simulation updates,
 //              providing interaction methods for Elements.
@@ -14,11 +14,32 @@
 
 #include <vector>
 #include <memory>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include "Particle.h"
 #include "Element.h"
+#include "AlignedAllocator.h"
+#include "ElementPool.h"
+#include "WorldChunk.h"
+#include "Random.h"
+#include "SimulationStats.h"
 
 // Forward declaration
 class Element;
+class JobSystem;
+class Profiler;
+
+/**
+ * @brief Flat, row-major cell storage used by the World.
+ * Rows are padded out to a stride so every row starts on a cache line.
+ */
+using ElementGrid = std::vector<ElementPtr, AlignedAllocator<ElementPtr>>;
+
+/**
+ * @brief Per-cell tick stamps, laid out exactly like an ElementGrid.
+ */
+using ClaimStampGrid = std::vector<std::uint16_t, AlignedAllocator<std::uint16_t>>;
 
 /**
  * @brief Structure to hold information for pending element placements.
@@ -37,24 +58,81 @@ struct PlacementRequest {
 /**
  * @brief Manages the simulation grid and element interactions.
  *
- * Handles the storage of elements using unique pointers in a double buffer,
- * handles the update cycle, and manages element placement requests.
+ * Handles the storage of elements using unique pointers in a single grid that
+ * is updated in place, handles the update cycle, and manages element placement
+ * requests. Element objects themselves live in per-type ElementPools owned by the World.
+ *
+ * The grid is a single contiguous row-major array with a padded row stride.
+ * Cells can be addressed either by (r, c) or by flat index (see index()).
+ *
+ * Every cell has a claim stamp. A cell that receives an element during a tick
+ * (by a move, swap or replacement) is stamped with that tick's epoch, which
+ * both blocks further moves into it and stops the arriving element from being
+ * updated a second time in the same tick. Elements replaced during a tick are
+ * kept alive until the sweep has finished, since the element doing the
+ * replacing is usually the one being replaced.
+ *
+ * The grid is also divided into CHUNK_SIZE x CHUNK_SIZE chunks that track
+ * dirty rectangles, so each tick only visits cells near recent activity.
+ * Within those rectangles the sweep walks an awake bitset (one bit per cell,
+ * mirroring Element::isAwake()) so sleeping cells are skipped 64 at a time.
+ *
+ * When given a multi-threaded JobSystem (see setJobSystem()) the grid is updated
+ * in parallel in four checkerboard phases of chunk-sized tiles. Tiles in the same
+ * phase are at least one whole tile apart, which is more than twice
+ * MAX_INTERACTION_REACH, so their updates never touch the same cells (or the
+ * same chunk) and need no locking. The tile grid is shifted by an offset that
+ * changes every tick, so no boundary between phases stays in one place.
  *
  * Provides methods for elements to query their neighbours and request moves/swaps.
  */
 class World
 {
 public:
+    // **=== Constants ===**
+    /** @brief Width and height of a chunk in cells. */
+    static constexpr int CHUNK_SIZE = 32;
+
+    /**
+     * @brief Furthest distance (in cells) an element update may read or write from its own cell.
+     * Liquids look up to their dispersion rate (7 for water) sideways, plus the cell
+     * above the target. Wakes are only requested during the sweep and applied
+     * afterwards, so they do not add to the reach.
+     */
+    static constexpr int MAX_INTERACTION_REACH = 10;
+    static_assert(CHUNK_SIZE >= 2 * MAX_INTERACTION_REACH, "Same-phase tiles must not share a neighbourhood.");
+    static_assert(CHUNK_SIZE < 256, "Chunk-relative surface rows are stored in a byte.");
+
+    /**
+     * @brief How far the parallel update's tile grid shifts each tick, in rows and columns
+     * (modulo CHUNK_SIZE). Odd, so every offset comes round once per CHUNK_SIZE ticks.
+     */
+    static constexpr int TILE_SHIFT_ROWS = 11;
+    static constexpr int TILE_SHIFT_COLS = 19;
+
+    /** @brief Largest wake radius an element type can have (see setWakeRadius()). */
+    static constexpr int MAX_WAKE_RADIUS = 2;
+    /** @brief Wake radius of every type unless changed (the 5x5 neighbourhood). */
+    static constexpr int DEFAULT_WAKE_RADIUS = 2;
+
+    /** @brief Seed used when none is given, so runs are reproducible by default. */
+    static constexpr std::uint64_t DEFAULT_SEED = 0x5EED;
+
     // **=== Constructors & Destructors ===**
 
     /**
      * @brief Constructs a World object with a grid of the specified dimensions.
      * @param numRows The number of rows in the grid.
      * @param numCols The number of columns in the grid.
+     * @param seed Seed of the random streams (see setSeed()).
      */
-    World(int numRows, int numCols);
+    World(int numRows, int numCols, std::uint64_t seed = DEFAULT_SEED);
 
     // Defauld destructor is okay for now as unique_ptrs will handle cleanup themselves.
+    // (Pools are declared before the grids so they outlive every pooled element.)
+
+    World(const World&) = delete;
+    World& operator=(const World&) = delete;
 
     // **=== Public Methods ===**
 
@@ -88,14 +166,32 @@ public:
 
     // -- Getters --
      /**
-     * @brief Get the pre-calculated surface height for a given column.
+     * @brief Get the surface height for a given column.
      * The surface height is the row index of the first non-empty cell from the top (0).
      * Returns numRows if the column is empty.
+     *
+     * Heights are maintained incrementally as cells fill and empty, so this only
+     * reads one byte per chunk row above the surface. Safe to call from any thread;
+     * while an update is running the result may briefly be above the true surface.
      * @param c The column index.
      * @return int The row index of the highest element, or numRows if empty.
      */
     int getSurfaceHeight(int c) const;
 
+    // -- Debugging --
+    /**
+     * @brief Enables checking the incremental surface heights against a full rescan after every update.
+     * A mismatch throws std::logic_error. On by default in debug builds (NDEBUG not defined).
+     * @param enabled true to validate.
+     */
+    void setSurfaceHeightValidation(bool enabled) { m_validateSurfaceHeights = enabled; }
+
+    /**
+     * @brief Checks if surface height validation is enabled.
+     * @return true if every update rescans and checks the surface heights.
+     */
+    bool isSurfaceHeightValidationEnabled() const { return m_validateSurfaceHeights; }
+
     /**
      * @brief Gets a pointer to the element in the current grid (m_grid).
      *
@@ -106,14 +202,14 @@ public:
     Element* getElement(int r, int c) const;
 
     /**
-     * @brief Gets a pointer to the element in the next grid state (m_nextGrid).
+     * @brief Checks if a cell has already received an element this tick (by a move, swap or replacement).
      *
-     * Useful for checks within element update logic against the next state.
+     * Useful for checks within element update logic; claimed cells reject tryMoveOrSwap().
      * @param r The row index.
      * @param c The column index.
-     * @return Element* Pointer to the element, or nullptr if out of bounds or empty.
+     * @return true if the cell is claimed for this tick, false if not or out of bounds.
      */
-    Element* getElementFromNext(int r, int c) const;
+    bool isClaimedThisTick(int r, int c) const;
 
     /**
      * @brief Gets the ParticleType of the element at (r, c) in the current grid.
@@ -125,9 +221,18 @@ public:
 
     /**
      * @brief Gets the current state of the simulation grid (m_grid).
-     * @return Const reference to the grid of unique element pointers.
+     * Cells are stored row-major; use index() or getStride() to address them.
+     * @return Const reference to the flat grid of unique element pointers.
+     */
+    const ElementGrid& getGridState() const;
+
+    /**
+     * @brief Gets a pointer to the element at a flat cell index in the current grid.
+     * No bounds checking; the index must come from index() with in-bounds coordinates.
+     * @param idx The flat cell index.
+     * @return Element* Pointer to the element, or nullptr if empty.
      */
-    const std::vector<std::vector<std::unique_ptr<Element>>>& getGridState() const;
+    Element* getElementAt(int idx) const { return m_grid[idx].get(); }
 
     /**
      * @brief Get the number of rows in the grid.
@@ -141,6 +246,175 @@ public:
      */
     int getCols() const;
 
+    /**
+     * @brief Get the row stride of the flat grid (columns padded to a cache line multiple).
+     * @return int The number of cells between the starts of consecutive rows.
+     */
+    int getStride() const { return m_stride; }
+
+    /**
+     * @brief Converts (r, c) coordinates into a flat cell index. No bounds checking.
+     * @param r The row index.
+     * @param c The column index.
+     * @return int The flat index into the grid buffers.
+     */
+    int index(int r, int c) const { return r * m_stride + c; }
+
+    /**
+     * @brief Gets the flat index offset of a neighbour relative to a cell.
+     * @param dr Row delta.
+     * @param dc Column delta.
+     * @return int The value to add to a cell's flat index to reach the neighbour.
+     */
+    int neighborOffset(int dr, int dc) const { return dr * m_stride + dc; }
+
+    /**
+     * @brief Gets the occupancy counters of the element pool for a type.
+     * inUse and peakInUse count the live elements of the type, wherever their slots
+     * are (a morphed element keeps the slot of its old type's pool, see morphElement()).
+     * @param type The ParticleType to query.
+     * @return ElementPoolStats The pool's counters (all zero if no element of that type was ever created).
+     */
+    ElementPoolStats getPoolStats(ParticleType type) const;
+
+    /**
+     * @brief Gets the pool counters summed over every particle type.
+     * @return ElementPoolStats Combined counters (type is EMPTY).
+     */
+    ElementPoolStats getTotalPoolStats() const;
+
+    // -- Chunk Info --
+    /**
+     * @brief Get the total number of chunks the grid is divided into.
+     * @return int The chunk count.
+     */
+    int getChunkCount() const { return static_cast<int>(m_chunks.size()); }
+
+    /**
+     * @brief Get the number of chunks that had work in the most recent tick.
+     * @return int The active chunk count.
+     */
+    int getActiveChunkCount() const { return m_activeChunkCount; }
+
+    /**
+     * @brief Counts the cells whose element is awake.
+     * @return int The number of set bits in the awake bitset.
+     */
+    int getAwakeCellCount() const;
+
+    // -- Changed Areas --
+    /**
+     * @brief Collects the areas whose cells changed since the last call (placements, moves,
+     * swaps, replacements and type changes), at most one rectangle per chunk, and forgets them.
+     * Renderers use these to repaint only what changed. Call between updates, on the thread that runs them.
+     * @param areas Cleared, then filled with the changed areas (never overlapping).
+     */
+    void takeChangedAreas(std::vector<DirtyRect>& areas);
+
+    // -- Wake Settings --
+    /**
+     * @brief Sets how far around a moving element of a type its neighbours are woken.
+     * 0 wakes nothing, 1 the 3x3 neighbourhood, 2 the 5x5 neighbourhood.
+     * @param type The ParticleType of the moving (or placed) element.
+     * @param radius The wake radius, 0 to MAX_WAKE_RADIUS.
+     */
+    void setWakeRadius(ParticleType type, int radius);
+
+    /**
+     * @brief Gets the wake radius of a type.
+     * @param type The ParticleType to query.
+     * @return int The radius in cells.
+     */
+    int getWakeRadius(ParticleType type) const { return m_wakeRadius[static_cast<size_t>(type)]; }
+
+    // -- Threading --
+    /**
+     * @brief Sets the job system used by update() for parallel work.
+     * nullptr (the default) or a single-threaded JobSystem keeps the original
+     * single-threaded whole-world sweep. Otherwise chunk updates and the surface
+     * height scan are submitted to the job system.
+     * @param jobs The job system (not owned; must outlive its use by the World), or nullptr.
+     */
+    void setJobSystem(JobSystem* jobs);
+
+    /**
+     * @brief Gets the job system used by update(), if any.
+     * @return JobSystem* The job system, or nullptr when single-threaded.
+     */
+    JobSystem* getJobSystem() const { return m_jobs; }
+
+    /**
+     * @brief Gets the number of threads used by update().
+     * @return int The thread count (1 when single-threaded).
+     */
+    int getThreadCount() const;
+
+    // -- Update Order --
+    /**
+     * @brief Chooses how the sweep orders the cells of each chunk row.
+     * Off (the default): cells are updated strictly in sweep order. On: the row's
+     * awake cells are first sorted into one list per ParticleType (each still in
+     * sweep order), then each type's update runs over its whole list, so the
+     * element code stays hot in the caches. Rows are still updated bottom-up.
+     * Both modes update the same cells, but in a different order, so runs differ.
+     * @param enabled true to batch by type.
+     */
+    void setBatchByType(bool enabled) { m_batchByType = enabled; }
+
+    /**
+     * @brief Checks if the sweep batches each row by type (see setBatchByType()).
+     * @return true if batching.
+     */
+    bool isBatchingByType() const { return m_batchByType; }
+
+    // -- Profiling --
+    /**
+     * @brief Sets the profiler that update() records its phase timings to.
+     * @param profiler The profiler (not owned; must outlive its use by the World), or nullptr to stop profiling.
+     */
+    void setProfiler(Profiler* profiler) { m_profiler = profiler; }
+
+    /**
+     * @brief Gets the profiler update() records to, if any.
+     * @return Profiler* The profiler, or nullptr.
+     */
+    Profiler* getProfiler() const { return m_profiler; }
+
+    // -- Event Counters --
+    /**
+     * @brief Gets the event counters of the most recent tick.
+     * Each thread counts into its own SimulationStats during the tick; they are merged at its end.
+     * @return const SimulationStats& The counters.
+     */
+    const SimulationStats& getLastTickStats() const { return m_lastTickStats; }
+
+    /**
+     * @brief Gets the event counters summed over every tick since the last resetTotalStats().
+     * @return const SimulationStats& The counters.
+     */
+    const SimulationStats& getTotalStats() const { return m_totalStats; }
+
+    /**
+     * @brief Sets the summed event counters back to zero.
+     */
+    void resetTotalStats() { m_totalStats.clear(); }
+
+    // -- Random Numbers --
+    /**
+     * @brief Restarts every chunk's random stream from a seed.
+     * Each chunk draws from its own stream, and a chunk is only ever updated by
+     * one thread at a time, so the same seed and inputs replay the same run no
+     * matter how the job system spreads chunks over its threads.
+     * @param seed The seed.
+     */
+    void setSeed(std::uint64_t seed);
+
+    /**
+     * @brief Gets the seed the random streams were last started from.
+     * @return std::uint64_t The seed.
+     */
+    std::uint64_t getSeed() const { return m_seed; }
+
 
     // **=== Methods for Element Interaction ===**
 
@@ -153,9 +427,9 @@ public:
     bool isWithinBounds(int r, int c) const;
 
     /**
-     * @brief Attempts to move/swap element from (r_from, c_from) in m_grid
-     * to (r_to, c_to) in m_nextGrid. Checks nextGrid availability and original
-     * occupant type/density to decide on move/swap/fail.
+     * @brief Attempts to move/swap the element at (r_from, c_from) to (r_to, c_to).
+     * Fails if the target was already claimed this tick; otherwise moves into an
+     * empty target or swaps with a less dense fluid, claiming the cells it fills.
      * @param r_from Source row index.
      * @param c_from Source column index.
      * @param r_to Target row index.
@@ -165,58 +439,95 @@ public:
     bool tryMoveOrSwap(int r_from, int c_from, int r_to, int c_to);
 
     /**
-     * @brief Moves the element pointer from m_grid[from] to m_nextGrid[to].
-     * Assumes necessary checks have been made by caller.
-     * @param r_from Source row index.
-     * @param c_from Source column index.
-     * @param r_to Target row index.
-     * @param c_to Target column index.
-     */
-    void moveElementToNext(int r_from, int c_from, int r_to, int c_to); // *** Declaration Included ***
-
-    /**
-     * @brief Swaps element pointers between m_grid locations into m_nextGrid.
-     * Assumes necessary checks have been made by caller.
-     * @param r1 Row index of the first element location.
-     * @param c1 Column index of the first element location.
-     * @param r2 Row index of the second element location.
-     * @param c2 Column index of the second element location.
-     */
-    void swapElementsInNext(int r1, int c1, int r2, int c2); // *** Declaration Included ***
-
-    /**
-     * @brief Directly sets the element pointer for a cell in the next grid (m_nextGrid).
+     * @brief Replaces the element in a cell and claims the cell for this tick.
      *
-     * Used internally by other methods.
+     * Used by elements that change type (e.g. dirt growing into grass). The old
+     * element is not destroyed until the end of the tick's sweep, so it is safe
+     * for an element to replace itself and carry on with its update.
      * @param r The row index.
      * @param c The column index.
-     * @param element A unique_ptr to the element to place (ownership transferred).
+     * @param element An owning pointer to the element to place (ownership transferred).
      */
-    void setNextElement(int r, int c, std::unique_ptr<Element> element);
+    void replaceElement(int r, int c, ElementPtr element);
 
     /**
-     * @brief Clears a cell in the next grid (m_nextGrid), setting it to nullptr.
+     * @brief Changes the type of the element in a cell in place and claims the cell for this tick.
+     *
+     * Used for transitions such as dirt <-> grass and water -> steam. The new element is
+     * built in the old one's pool slot (no allocation) and inherits its temperature
+     * and color variant (see Element::inheritMorphState()), so it keeps its shade. Per-type state
+     * such as timers starts fresh. If the new class does not fit the old slot, a new
+     * element is created and swapped in with replaceElement() instead.
+     *
+     * Unlike replaceElement(), the old element is destroyed at once: an element that
+     * morphs itself must return from its update without touching its members again.
      * @param r The row index.
      * @param c The column index.
+     * @param newType The type to become.
+     * @return true if the cell changed type; false if it is empty or out of bounds, already
+     * of that type, or the type has no element class yet.
      */
-    void clearNextGridCell(int r, int c);
+    bool morphElement(int r, int c, ParticleType newType);
 
     /**
-     * @brief Creates a unique_ptr to a specific Element subclass based on type. (Factory)
+     * @brief Creates a specific Element subclass based on type. (Factory)
+     * The element is constructed in the World's pool for that type, and its color
+     * variant is seeded from the cell it is made for (see Element::seedColorVariant()).
      * @param type The ParticleType to create.
-     * @return std::unique_ptr<Element> Pointer to the new element, or nullptr.
+     * @param r The row the element is made for.
+     * @param c The column the element is made for.
+     * @return ElementPtr Owning pointer to the new element, or nullptr.
+     */
+    ElementPtr createElementByType(ParticleType type, int r, int c);
+
+    /**
+     * @brief Gets the random stream for an element at a cell to draw from. No bounds checking.
+     * The stream belongs to the cell's chunk; only use it while updating that cell.
+     * @param r The row index.
+     * @param c The column index.
+     * @return Random& The chunk's random stream.
      */
-    std::unique_ptr<Element> createElementByType(ParticleType type);
+    Random& getRandom(int r, int c) { return chunkAt(r, c).random; }
 
 
 private:
+    /** @brief Lets the micro benchmarks run single steps of a tick (see MicroBenchmarkMain.cpp). */
+    friend struct WorldBenchmarkAccess;
+
+    // **=== Private Types ===**
+
+    /**
+     * @brief Lists that one thread appends to during the sweep.
+     * Cache-line aligned so threads appending to their own lists never share a line.
+     */
+    struct alignas(CACHE_LINE_SIZE) ThreadScratch {
+        /** @brief Elements replaced during the sweep, freed once it has finished. */
+        std::vector<ElementPtr> retiredElements;
+        /** @brief Column segments whose top cell was emptied, rescanned once the sweep has finished. */
+        std::vector<int> staleSegments;
+        /** @brief Events counted by this thread, merged into m_lastTickStats at the end of the tick. */
+        SimulationStats stats;
+        /** @brief The current chunk row's awake cells per ParticleType, when batching by type. */
+        std::array<std::vector<int>, PARTICLE_TYPE_COUNT> typeBatches;
+    };
+
     // **=== Private Members ===**
 
+    // -- Element Storage --
+    /** @brief Live elements per type across the pools. Must be declared before the pools and grids. */
+    ElementCensus m_census;
+    /** @brief One slab pool per ParticleType, created by the constructor. Must be declared before the grids. */
+    std::array<std::unique_ptr<ElementPool>, PARTICLE_TYPE_COUNT> m_pools;
+
     // -- Grids --
     /** @brief The main grid representing the current simulation state. */
-    std::vector<std::vector<std::unique_ptr<Element>>> m_grid;
-    /** @brief The grid used to calculate the next simulation state. */
-    std::vector<std::vector<std::unique_ptr<Element>>> m_nextGrid;
+    ElementGrid m_grid;
+    /** @brief Epoch of the tick in which each cell was last claimed (same layout as m_grid). */
+    ClaimStampGrid m_claimStamps;
+    /** @brief Epoch of the current tick. Never 0, so a freshly cleared stamp is never a claim. */
+    std::uint16_t m_tickEpoch = 0;
+    /** @brief One set of sweep lists per thread. Holds retired elements, so it must be declared after the pools. */
+    std::vector<ThreadScratch> m_threadScratch;
     /** @brief Buffer for element placement requests from user input or other sources. */
     std::vector<PlacementRequest> m_placementRequests;
 
@@ -225,27 +536,381 @@ private:
     int m_rows;
     /** @brief Number of columns in the simulation grid. */
     int m_cols;
-    /** @brief Stores the calculated row index of the highest non-empty element in each column. */
-    std::vector<int> m_surfaceHeights;
+    /**
+     * @brief Row stride of the flat grid; m_cols plus MAX_WAKE_RADIUS padding cells, rounded
+     * up to a whole number of cache lines. The padding keeps wake dilation inside each row.
+     */
+    int m_stride;
+
+    // -- Chunks --
+    /** @brief Chunks in row-major order, m_chunkRows x m_chunkCols. */
+    std::vector<WorldChunk> m_chunks;
+    /** @brief Number of chunk rows (grid rows / CHUNK_SIZE, rounded up). */
+    int m_chunkRows;
+    /** @brief Number of chunk columns (grid cols / CHUNK_SIZE, rounded up). */
+    int m_chunkCols;
+    /** @brief Number of chunks with a non-empty current rectangle in the last tick. */
+    int m_activeChunkCount = 0;
+    /** @brief Seed the chunks' random streams were started from. */
+    std::uint64_t m_seed = DEFAULT_SEED;
+    /** @brief Tiles with work for each of the four checkerboard phases (rebuilt each parallel tick). */
+    std::array<std::vector<DirtyRect>, 4> m_phaseTiles;
+
+    // -- Awake Cells --
+    /**
+     * @brief One bit per cell (bit idx % 64 of word idx / 64, for flat index idx), set while
+     * the cell holds an awake element. Atomic because neighbouring chunks share words.
+     */
+    std::vector<std::atomic<std::uint64_t>> m_awakeBits;
+
+    // -- Wake Requests --
+    /**
+     * @brief One request bitset per wake radius (index radius - 1), same layout as m_awakeBits.
+     * A set bit asks for every element within that radius of the cell to be woken.
+     */
+    std::array<std::vector<std::atomic<std::uint64_t>>, MAX_WAKE_RADIUS> m_wakeRequests;
+    /** @brief Bounding rectangle of all cells with a wake request this tick. */
+    AtomicDirtyRect m_wakeArea;
+    /** @brief Wake radius of each ParticleType. */
+    std::array<int, PARTICLE_TYPE_COUNT> m_wakeRadius;
+
+    // -- Surface Heights --
+    /**
+     * @brief Topmost occupied row of each column segment (one column within one chunk row),
+     * relative to the chunk row, or CHUNK_SIZE if the segment is empty. Indexed chunkRow * m_cols + column.
+     * Never below the true top: filling a cell lowers it at once, emptying the top cell
+     * defers the rescan to the end of the sweep.
+     */
+    std::vector<std::atomic<std::uint8_t>> m_segmentTops;
+    /** @brief Whether update() checks m_segmentTops against a full rescan. */
+    bool m_validateSurfaceHeights;
+
+    // -- Threading --
+    /** @brief Job system for the parallel update, or nullptr when single-threaded. Not owned. */
+    JobSystem* m_jobs = nullptr;
+    /** @brief Receives the phase timings of update(); nullptr when not profiling. */
+    Profiler* m_profiler = nullptr;
+
+    // -- Event Counters --
+    /** @brief Merged event counters of the most recent tick. */
+    SimulationStats m_lastTickStats;
+    /** @brief Event counters summed over every tick since the last resetTotalStats(). */
+    SimulationStats m_totalStats;
 
     // -- Update Logic State --
     /** @brief Tracks the column sweep direction for the update loop (alternates each frame). */
     bool m_sweepRight = true;
+    /** @brief Number of update() calls so far; picks the parallel tile offset. */
+    std::uint64_t m_tickCount = 0;
+    /** @brief Whether chunk rows are updated in per-type batches (see setBatchByType()). */
+    bool m_batchByType = false;
 
 
     // **=== Private Methods ===**
 
     /**
-     * @brief Calculates the surface height for all columns and stores it in m_surfaceHeights.
-     * Should be called once at the beginning of the World::update cycle.
+     * @brief Creates the (initially empty) pool that holds elements of type T.
+     * @tparam T The concrete Element subclass.
+     * @param type The ParticleType that T represents.
+     */
+    template <typename T>
+    void createPool(ParticleType type) {
+        m_pools[static_cast<size_t>(type)] = std::make_unique<ElementPool>(type, sizeof(T), alignof(T));
+        m_pools[static_cast<size_t>(type)]->setCensus(&m_census);
+    }
+
+    /**
+     * @brief Constructs an element of type T in the pool for the given type.
+     * The pool must already exist (see createPool()).
+     * @tparam T The concrete Element subclass.
+     * @param type The ParticleType that T represents.
+     * @param args Arguments forwarded to T's constructor.
+     * @return ElementPtr Owning pointer to the new element.
+     */
+    template <typename T, typename... Args>
+    ElementPtr makePooled(ParticleType type, Args&&... args) {
+        return ElementPtr(m_pools[static_cast<size_t>(type)]->construct<T>(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief Records that a cell became occupied, raising its column segment's top if needed. Thread-safe.
+     * @param r The row index.
+     * @param c The column index.
+     */
+    void noteCellOccupied(int r, int c);
+
+    /**
+     * @brief Records that a cell became empty. If it was its segment's top, the segment
+     * is queued on the calling thread's stale list for resolveStaleSegments().
+     * @param r The row index.
+     * @param c The column index.
+     */
+    void noteCellVacated(int r, int c);
+
+    /**
+     * @brief Rescans a column segment downwards from its stored top to find the real one.
+     * @param segment The segment index (chunkRow * m_cols + column).
+     */
+    void refreshSegmentTop(int segment);
+
+    /**
+     * @brief Rescans every segment queued by noteCellVacated() during the sweep.
+     */
+    void resolveStaleSegments();
+
+    /**
+     * @brief Compares every column's surface height against a full top-down rescan.
+     * Throws std::logic_error on the first mismatch.
+     */
+    void validateSurfaceHeights() const;
+
+    /**
+     * @brief Gets the chunk containing a cell. No bounds checking.
+     * @param r The row index.
+     * @param c The column index.
+     * @return WorldChunk& The containing chunk.
+     */
+    WorldChunk& chunkAt(int r, int c) { return m_chunks[(r / CHUNK_SIZE) * m_chunkCols + (c / CHUNK_SIZE)]; }
+
+    /**
+     * @brief Adds a cell to its chunk's pending dirty rectangle. No bounds checking.
+     * @param r The row index.
+     * @param c The column index.
+     */
+    void markDirty(int r, int c) { chunkAt(r, c).pending.include(r, c); }
+
+    /**
+     * @brief Marks a cell whose contents changed: dirty for the next tick, and part of
+     * its chunk's changed area (see takeChangedAreas()). No bounds checking.
+     * @param r The row index.
+     * @param c The column index.
+     */
+    void markChanged(int r, int c) {
+        WorldChunk& chunk = chunkAt(r, c);
+        chunk.pending.include(r, c);
+        chunk.changed.include(r, c);
+    }
+
+    /**
+     * @brief Adds an inclusive area to the pending dirty rectangles of every chunk it overlaps.
+     * The area is clipped to the grid first.
+     * @param r0 Top row.
+     * @param c0 Left column.
+     * @param r1 Bottom row.
+     * @param c1 Right column.
+     */
+    void markDirtyArea(int r0, int c0, int r1, int c1);
+
+    /**
+     * @brief Makes each chunk's pending rectangle current and clears the pending one.
+     * Called at the start of a tick, after placement requests are applied.
+     */
+    void beginChunkTick();
+
+    /**
+     * @brief Runs the update sweep one row at a time across the whole world (single-threaded).
+     */
+    void updateSerial();
+
+    /**
+     * @brief Runs the update sweep tile by tile in four checkerboard phases on the job system.
+     * The tiles are chunk-sized, with the tile grid shifted up and left by a per-tick offset.
+     */
+    void updateParallel();
+
+    /**
+     * @brief Checks if a tile overlaps the current rectangle of any chunk.
+     * @param tile The tile's cells, inside the grid.
+     * @return true if the tile has work this tick.
+     */
+    bool tileHasWork(const DirtyRect& tile) const;
+
+    /**
+     * @brief Updates the part of every chunk's current rectangle inside a tile, bottom-up.
+     * @param tile The tile's cells, inside the grid.
+     */
+    void updateTile(const DirtyRect& tile);
+
+    /**
+     * @brief Updates the awake elements in one row of a chunk, between two columns.
+     * Walks the set bits of the awake bitset in the current sweep direction, or
+     * hands the row to updateChunkRowBatched() when batching by type.
+     * @param r The row index.
+     * @param minC First column (inside the chunk's current rectangle).
+     * @param maxC Last column (inside the same chunk's current rectangle).
+     */
+    void updateChunkRow(int r, int minC, int maxC);
+
+    /**
+     * @brief Updates one chunk row's columns in per-type batches (see setBatchByType()).
+     * @param r The row index.
+     * @param minC First column.
+     * @param maxC Last column.
+     * @param scratch The calling thread's sweep lists.
+     */
+    void updateChunkRowBatched(int r, int minC, int maxC, ThreadScratch& scratch);
+
+    /**
+     * @brief Runs one type's update over a batch of cells from the same row.
+     * @tparam Kernel Callable (Element&, int r, int c) that updates one element.
+     * @param batch Flat indices of the cells, in sweep order.
+     * @param r The row index.
+     * @param rowStart Flat index of column 0 of the row.
+     * @param counts The type's event counters.
+     * @param kernel The update to run.
+     */
+    template <typename Kernel>
+    void runUpdateBatch(const std::vector<int>& batch, int r, int rowStart, TypeEventCounts& counts, const Kernel& kernel);
+
+    /**
+     * @brief Updates the element in one awake cell, unless it arrived there this tick.
+     * @param r The row index.
+     * @param c The column index.
+     * @param idx The flat cell index of (r, c).
+     * @param stats The calling thread's event counters.
+     */
+    void updateCell(int r, int c, int idx, SimulationStats& stats);
+
+    /**
+     * @brief Brings a cell's dirty rectangle and awake bit up to date after its element updated.
+     * @param element The element that was updated (it may have moved away since).
+     * @param r The row index.
+     * @param c The column index.
+     * @param idx The flat cell index of (r, c).
+     * @param counts The element type's event counters.
+     */
+    void finishCellUpdate(const Element* element, int r, int c, int idx, TypeEventCounts& counts);
+
+    /**
+     * @brief Runs an element's update() through a switch on its ParticleType,
+     * generated from FS_FOR_EACH_ELEMENT_CLASS, instead of through the vtable.
+     * @param element The element to update.
+     * @param r The row index.
+     * @param c The column index.
+     */
+    void dispatchUpdate(Element& element, int r, int c);
+
+    /**
+     * @brief Sets a cell's awake bit. Thread-safe.
+     * @param idx The flat cell index.
+     */
+    void setAwakeBit(int idx) {
+        const std::uint64_t bit = std::uint64_t{ 1 } << (idx & 63);
+        std::atomic<std::uint64_t>& word = m_awakeBits[idx >> 6];
+        if (!(word.load(std::memory_order_relaxed) & bit)) { // Skip the locked write if already set
+            word.fetch_or(bit, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Clears a cell's awake bit. Thread-safe.
+     * @param idx The flat cell index.
+     */
+    void clearAwakeBit(int idx) {
+        const std::uint64_t bit = std::uint64_t{ 1 } << (idx & 63);
+        std::atomic<std::uint64_t>& word = m_awakeBits[idx >> 6];
+        if (word.load(std::memory_order_relaxed) & bit) {
+            word.fetch_and(~bit, std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Makes a cell's awake bit match its element (set only if there is one and it is awake).
+     * @param idx The flat cell index.
+     */
+    void syncAwakeBit(int idx) {
+        Element* element = m_grid[idx].get();
+        if (element && element->isAwake()) {
+            setAwakeBit(idx);
+        }
+        else {
+            clearAwakeBit(idx);
+        }
+    }
+
+    /**
+     * @brief Advances the tick epoch used by the claim stamps.
+     * When the 16-bit epoch wraps, all stamps are cleared so old stamps cannot
+     * be mistaken for claims made in the new tick.
+     */
+    void advanceTickEpoch();
+
+    /**
+     * @brief Checks if a cell was claimed in the current tick. No bounds checking.
+     * @param idx The flat cell index.
+     * @return true if claimed.
+     */
+    bool isClaimed(int idx) const { return m_claimStamps[idx] == m_tickEpoch; }
+
+    /**
+     * @brief Claims a cell for the current tick. No bounds checking.
+     * @param idx The flat cell index.
+     */
+    void claimCell(int idx) { m_claimStamps[idx] = m_tickEpoch; }
+
+    /**
+     * @brief Gets the calling thread's sweep lists.
+     * @return ThreadScratch& Worker threads get their own; any other thread gets entry 0.
+     */
+    ThreadScratch& threadScratch();
+
+    /**
+     * @brief Keeps a replaced element alive until the end of the sweep.
+     * Uses the calling thread's own list, so it is safe during the parallel update.
+     * @param element The replaced element (may be null).
      */
-    void calculateSurfaceHeights();
+    void retireElement(ElementPtr element);
 
     /**
-     * @brief Wakes up elements in a neighborhood around the given cell.
-     * Called after a move/swap to ensure neighbours react on the next tick.
+     * @brief Frees every element retired during the sweep.
+     */
+    void releaseRetiredElements();
+
+    /**
+     * @brief Merges every thread's event counters into m_lastTickStats and m_totalStats, then clears them.
+     */
+    void mergeThreadStats();
+
+    /**
+     * @brief Asks for the elements in a neighbourhood around the given cell to be woken. Thread-safe.
+     * Called after a move/swap or placement so neighbours react on the next tick.
+     * Requests are only recorded here; applyWakeRequests() wakes them all at once.
      * @param r Central row index.
      * @param c Central column index.
+     * @param radius Neighbourhood radius (0 to MAX_WAKE_RADIUS; 0 does nothing).
+     */
+    void requestWake(int r, int c, int radius) {
+        if (radius <= 0) {
+            return;
+        }
+        const int idx = index(r, c);
+        const std::uint64_t bit = std::uint64_t{ 1 } << (idx & 63);
+        std::atomic<std::uint64_t>& word = m_wakeRequests[radius - 1][idx >> 6];
+        if (!(word.load(std::memory_order_relaxed) & bit)) { // Repeat requests cost one load
+            word.fetch_or(bit, std::memory_order_relaxed);
+        }
+        m_wakeArea.include(r, c);
+    }
+
+    /**
+     * @brief Wakes every element within its request's radius of a wake request, then clears the requests.
+     * Each request bitset is dilated by its radius with shifted word ORs, so a cell
+     * requested many times is still only visited once. Woken cells are marked dirty.
+     */
+    void applyWakeRequests();
+
+    /**
+     * @brief Applies the dilated wake requests to one row (see applyWakeRequests()).
+     * @param r The row index.
+     */
+    void applyWakeRow(int r);
+
+    /**
+     * @brief Reads 64 consecutive bits of a bitset starting at any bit position.
+     * Positions outside the bitset read as 0.
+     * @param bits The bitset words.
+     * @param bit Position of the first bit (may be negative).
+     * @return std::uint64_t Bit i is bit (bit + i) of the bitset.
      */
-    void wakeNeighbors(int r, int c);
+    static std::uint64_t loadBitWindow(const std::vector<std::atomic<std::uint64_t>>& bits, int bit);
 };
\ No newline at end of file
@@ -0,0 +1,180 @@
+// ============================================================================
+// Project:     Falling Sand Simulation
+// File:        WorldChunk.h
+// Author:      Foster Rae
+// Date Created:2026-10-16
+// Last Update: 2026-10-16
+// Version:     1.3
+// Description: Header file for the DirtyRect and WorldChunk structures.
+//              The World is split into fixed-size square chunks, each
+//              tracking the rectangle of cells that need processing so
+//              settled areas of the map can be skipped entirely.
+// ============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include "AlignedAllocator.h"
+#include "Random.h"
+
+/**
+ * @brief Inclusive rectangle of grid cells, in world (not chunk-local) coordinates.
+ * An empty rectangle has minR > maxR.
+ */
+struct DirtyRect {
+    int minR = INT_MAX;
+    int minC = INT_MAX;
+    int maxR = INT_MIN;
+    int maxC = INT_MIN;
+
+    /**
+     * @brief Checks if the rectangle covers no cells.
+     * @return true if empty.
+     */
+    bool isEmpty() const { return minR > maxR; }
+
+    /**
+     * @brief Empties the rectangle.
+     */
+    void reset() { *this = DirtyRect(); }
+
+    /**
+     * @brief Grows the rectangle to include a cell.
+     * @param r Row index.
+     * @param c Column index.
+     */
+    void include(int r, int c) {
+        minR = std::min(minR, r);
+        minC = std::min(minC, c);
+        maxR = std::max(maxR, r);
+        maxC = std::max(maxC, c);
+    }
+
+    /**
+     * @brief Grows the rectangle to include an inclusive area of cells.
+     * @param r0 Top row.
+     * @param c0 Left column.
+     * @param r1 Bottom row.
+     * @param c1 Right column.
+     */
+    void include(int r0, int c0, int r1, int c1) {
+        minR = std::min(minR, r0);
+        minC = std::min(minC, c0);
+        maxR = std::max(maxR, r1);
+        maxC = std::max(maxC, c1);
+    }
+
+    /**
+     * @brief Checks if a row falls within the rectangle.
+     * @param r Row index.
+     * @return true if minR <= r <= maxR.
+     */
+    bool containsRow(int r) const { return r >= minR && r <= maxR; }
+};
+
+/**
+ * @brief Dirty rectangle that several threads can grow at the same time.
+ *
+ * Each bound is widened with a compare-exchange loop that only writes when the
+ * bound actually moves, so the common already-covered case is four plain loads.
+ */
+struct AtomicDirtyRect {
+    std::atomic<int> minR{ INT_MAX };
+    std::atomic<int> minC{ INT_MAX };
+    std::atomic<int> maxR{ INT_MIN };
+    std::atomic<int> maxC{ INT_MIN };
+
+    /**
+     * @brief Grows the rectangle to include an inclusive area of cells. Thread-safe.
+     * @param r0 Top row.
+     * @param c0 Left column.
+     * @param r1 Bottom row.
+     * @param c1 Right column.
+     */
+    void include(int r0, int c0, int r1, int c1) {
+        lowerTo(minR, r0);
+        lowerTo(minC, c0);
+        raiseTo(maxR, r1);
+        raiseTo(maxC, c1);
+    }
+
+    /**
+     * @brief Grows the rectangle to include a cell. Thread-safe.
+     * @param r Row index.
+     * @param c Column index.
+     */
+    void include(int r, int c) { include(r, c, r, c); }
+
+    /**
+     * @brief Reads the rectangle and empties it. Not thread-safe against concurrent include().
+     * @return DirtyRect The rectangle as it was before the reset.
+     */
+    DirtyRect take() {
+        DirtyRect rect;
+        rect.minR = minR.exchange(INT_MAX, std::memory_order_relaxed);
+        rect.minC = minC.exchange(INT_MAX, std::memory_order_relaxed);
+        rect.maxR = maxR.exchange(INT_MIN, std::memory_order_relaxed);
+        rect.maxC = maxC.exchange(INT_MIN, std::memory_order_relaxed);
+        return rect;
+    }
+
+    /**
+     * @brief Reads the rectangle without changing it.
+     * @return DirtyRect The current bounds.
+     */
+    DirtyRect peek() const {
+        DirtyRect rect;
+        rect.minR = minR.load(std::memory_order_relaxed);
+        rect.minC = minC.load(std::memory_order_relaxed);
+        rect.maxR = maxR.load(std::memory_order_relaxed);
+        rect.maxC = maxC.load(std::memory_order_relaxed);
+        return rect;
+    }
+
+private:
+    static void lowerTo(std::atomic<int>& bound, int value) {
+        int current = bound.load(std::memory_order_relaxed);
+        while (value < current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+    static void raiseTo(std::atomic<int>& bound, int value) {
+        int current = bound.load(std::memory_order_relaxed);
+        while (value > current && !bound.compare_exchange_weak(current, value, std::memory_order_relaxed)) {}
+    }
+};
+
+/**
+ * @brief Fixed-size square region of the World with its own dirty tracking.
+ *
+ * Cells that were placed, moved into/out of, woken, or are still awake after
+ * their update are added to the pending rectangle. At the start of the next
+ * tick the pending rectangle becomes the current one; a chunk whose current
+ * rectangle is empty is asleep and is skipped by the update.
+ *
+ * The pending rectangle is atomic because, in the parallel update, the
+ * neighbours of a chunk may be processed by different threads at once. The
+ * changed rectangle, grown the same way, only covers cells whose contents
+ * changed (not merely woken ones), for renderers.
+ *
+ * Each chunk also owns a random stream, used by the elements inside it. Only
+ * one thread updates a chunk at a time, so the stream needs no locking, and
+ * its sequence does not depend on how chunks are spread over threads.
+ * Chunks are cache-line aligned so neighbouring streams never share a line.
+ */
+struct alignas(CACHE_LINE_SIZE) WorldChunk {
+    /** @brief Cells to process this tick (collected during the previous tick). */
+    DirtyRect current;
+    /** @brief Cells changed or woken during this tick (processed next tick). */
+    AtomicDirtyRect pending;
+    /** @brief Cells whose contents changed since a renderer last asked (see World::takeChangedAreas()). */
+    AtomicDirtyRect changed;
+    /** @brief Random stream for elements updated in this chunk. */
+    Random random;
+
+    /**
+     * @brief Checks if the chunk has any work this tick.
+     * @return true if the current dirty rectangle is non-empty.
+     */
+    bool isActive() const { return !current.isEmpty(); }
+};
\ No newline at end of file